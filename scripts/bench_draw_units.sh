@@ -0,0 +1,45 @@
+#!/bin/sh
+#
+# Frame time of the dashboard against the number of software draw units
+#
+# Usage: scripts/bench_draw_units.sh [frames] [backend]
+#
+# Builds the interface once per number of draw units, 1 to 4, in
+# build-units-<n> and redraws the whole screen <frames> times with each
+# build (default 300), on the given backend or the default one. Prints
+# the output of each run, then a Markdown table of the results and the
+# fastest count, to be used as the LV_DRAW_SW_DRAW_UNIT_CNT default.
+
+set -e
+
+FRAMES=${1:-300}
+BACKEND=${2:-}
+TABLE=""
+
+cd "$(dirname "$0")/.."
+
+for UNITS in 1 2 3 4; do
+    DIR="build-units-$UNITS"
+
+    cmake -S . -B "$DIR" -DDRAW_UNITS="$UNITS" > /dev/null
+    cmake --build "$DIR" -j"$(nproc)" --target dps150 > /dev/null
+
+    # -n: no device search while measuring
+    OUT=$("$DIR/bin/dps150" -n ${BACKEND:+-b "$BACKEND"} -D "$FRAMES" | grep "^draw bench:")
+    echo "$OUT"
+
+    # draw bench: frame <avg> ms average, <min> ms min, <max> ms max, <fps> frames/s
+    ROW=$(echo "$OUT" | awk -v u="$UNITS" '$3 == "frame" {
+        printf "| %d | %s | %s | %s | %s |", u, $4, $7, $10, $13 }')
+    TABLE="$TABLE$ROW
+"
+done
+
+echo
+echo "$(nproc) cores, $(uname -m), $FRAMES frames${BACKEND:+, $BACKEND}"
+echo
+echo "| Draw units | Average (ms) | Min (ms) | Max (ms) | Frames/s |"
+echo "|---|---|---|---|---|"
+printf "%s" "$TABLE"
+echo
+printf "%s" "$TABLE" | sort -t '|' -k3 -g | head -n 1 | awk -F '|' '{ gsub(/ /, "", $2); print "Fastest: " $2 " draw units" }'
@@ -0,0 +1,190 @@
+/**
+ * @file capture.c
+ *
+ * Serial capture files
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+
+#include "capture.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/* Writes are buffered, the I/O thread only copies into the stdio buffer */
+#define CAPTURE_BUFFER_SIZE (64 * 1024)
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void put_le(uint8_t *dst, uint64_t value, size_t size);
+static uint64_t get_le(const uint8_t *src, size_t size);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+int capture_create(capture_t *cap, const char *path)
+{
+    uint8_t header[CAPTURE_HEADER_LEN];
+    struct timespec ts;
+
+    memset(cap, 0, sizeof(*cap));
+
+    cap->file = fopen(path, "wb");
+    if (cap->file == NULL) {
+        return -1;
+    }
+    setvbuf(cap->file, NULL, _IOFBF, CAPTURE_BUFFER_SIZE);
+
+    clock_gettime(CLOCK_REALTIME, &ts);
+    cap->start_wall_us = (uint64_t)ts.tv_sec * 1000000u + (uint64_t)ts.tv_nsec / 1000u;
+
+    memcpy(header, CAPTURE_MAGIC, CAPTURE_MAGIC_LEN);
+    put_le(header + CAPTURE_MAGIC_LEN, cap->start_wall_us, 8);
+
+    if (fwrite(header, sizeof(header), 1, cap->file) != 1) {
+        fclose(cap->file);
+        cap->file = NULL;
+        return -1;
+    }
+
+    return 0;
+}
+
+void capture_write(capture_t *cap, capture_dir_t dir, const uint8_t *data, size_t len,
+                   uint64_t now_us)
+{
+    uint8_t header[CAPTURE_RECORD_HEADER_LEN];
+    uint64_t delta;
+    size_t chunk;
+
+    if (cap->file == NULL) {
+        return;
+    }
+
+    delta = cap->records > 0 ? now_us - cap->last_us : 0;
+    if (delta > UINT32_MAX) {
+        delta = UINT32_MAX;
+    }
+
+    while (len > 0) {
+        chunk = len < CAPTURE_RECORD_MAX ? len : CAPTURE_RECORD_MAX;
+
+        put_le(header, delta, 4);
+        header[4] = (uint8_t)dir;
+        header[5] = 0;
+        put_le(header + 6, chunk, 2);
+
+        fwrite(header, sizeof(header), 1, cap->file);
+        fwrite(data, chunk, 1, cap->file);
+
+        cap->records++;
+        cap->bytes += chunk;
+        data += chunk;
+        len -= chunk;
+        delta = 0;
+    }
+
+    cap->last_us = now_us;
+}
+
+int capture_open(capture_t *cap, const char *path)
+{
+    uint8_t header[CAPTURE_HEADER_LEN];
+
+    memset(cap, 0, sizeof(*cap));
+
+    cap->file = fopen(path, "rb");
+    if (cap->file == NULL) {
+        return -1;
+    }
+
+    if (fread(header, sizeof(header), 1, cap->file) != 1 ||
+        memcmp(header, CAPTURE_MAGIC, CAPTURE_MAGIC_LEN) != 0) {
+        fclose(cap->file);
+        cap->file = NULL;
+        errno = EINVAL;
+        return -1;
+    }
+
+    cap->start_wall_us = get_le(header + CAPTURE_MAGIC_LEN, 8);
+
+    return 0;
+}
+
+int capture_read(capture_t *cap, capture_record_t *rec)
+{
+    uint8_t header[CAPTURE_RECORD_HEADER_LEN];
+
+    if (cap->file == NULL || fread(header, sizeof(header), 1, cap->file) != 1) {
+        return -1;
+    }
+
+    rec->delta_us = (uint32_t)get_le(header, 4);
+    rec->dir = header[4];
+    rec->len = (uint16_t)get_le(header + 6, 2);
+    rec->data = cap->data;
+
+    if (rec->len > CAPTURE_RECORD_MAX ||
+        (rec->len > 0 && fread(cap->data, rec->len, 1, cap->file) != 1)) {
+        return -1;
+    }
+
+    cap->records++;
+    cap->bytes += rec->len;
+
+    return 0;
+}
+
+void capture_close(capture_t *cap)
+{
+    if (cap->file != NULL) {
+        fclose(cap->file);
+        cap->file = NULL;
+    }
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static void put_le(uint8_t *dst, uint64_t value, size_t size)
+{
+    size_t i;
+
+    for (i = 0; i < size; i++) {
+        dst[i] = (uint8_t)(value >> (8 * i));
+    }
+}
+
+static uint64_t get_le(const uint8_t *src, size_t size)
+{
+    uint64_t value = 0;
+    size_t i;
+
+    for (i = 0; i < size; i++) {
+        value |= (uint64_t)src[i] << (8 * i);
+    }
+
+    return value;
+}
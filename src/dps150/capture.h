@@ -0,0 +1,122 @@
+/**
+ * @file capture.h
+ *
+ * Serial capture files
+ *
+ * Raw bytes received from and written to the UART are recorded with
+ * their monotonic time, so a session can be replayed offline through
+ * the parser and the UI.
+ *
+ * File layout, integers are little endian:
+ *   header: "DPS150C1", u64 wall clock time of the first record in us
+ *   record: u32 time since the previous record in us, u8 direction,
+ *           u8 reserved, u16 length, data
+ *
+ */
+
+#ifndef CAPTURE_H
+#define CAPTURE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+
+#define CAPTURE_MAGIC "DPS150C1"
+#define CAPTURE_MAGIC_LEN 8
+#define CAPTURE_HEADER_LEN (CAPTURE_MAGIC_LEN + 8)
+#define CAPTURE_RECORD_HEADER_LEN 8
+
+/* Largest record, longer reads and writes are split */
+#define CAPTURE_RECORD_MAX 4096
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+typedef enum {
+    CAPTURE_DIR_RX = 0,
+    CAPTURE_DIR_TX = 1,
+} capture_dir_t;
+
+typedef struct {
+    FILE *file;
+    uint64_t last_us;           /* Monotonic time of the previous record */
+    uint64_t start_wall_us;
+    uint32_t records;
+    uint64_t bytes;
+    uint8_t data[CAPTURE_RECORD_MAX];   /* Reader: data of the current record */
+} capture_t;
+
+/* One record returned by capture_read */
+typedef struct {
+    uint32_t delta_us;
+    uint8_t dir;                /* capture_dir_t */
+    uint16_t len;
+    const uint8_t *data;        /* Valid until the next capture_read */
+} capture_record_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Create a capture file
+ * @param cap the capture
+ * @param path the file to create, truncated if it exists
+ * @return 0 on success, -1 with errno set on failure
+ */
+int capture_create(capture_t *cap, const char *path);
+
+/**
+ * Append bytes to a capture - a single thread may write
+ * @param cap the capture
+ * @param dir CAPTURE_DIR_RX or CAPTURE_DIR_TX
+ * @param data the bytes
+ * @param len the number of bytes
+ * @param now_us the monotonic time of the transfer
+ */
+void capture_write(capture_t *cap, capture_dir_t dir, const uint8_t *data, size_t len,
+                   uint64_t now_us);
+
+/**
+ * Open a capture file for replay
+ * @param cap the capture
+ * @param path the file to open
+ * @return 0 on success, -1 if it cannot be opened or is not a capture
+ */
+int capture_open(capture_t *cap, const char *path);
+
+/**
+ * Read the next record of a capture opened with capture_open
+ * @param cap the capture
+ * @param rec filled with the record
+ * @return 0 on success, -1 at the end of the file or if it is truncated
+ */
+int capture_read(capture_t *cap, capture_record_t *rec);
+
+/**
+ * Flush and close a capture
+ * @param cap the capture
+ */
+void capture_close(capture_t *cap);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*CAPTURE_H*/
@@ -0,0 +1,101 @@
+/**
+ * @file dps150_encode.c
+ *
+ * Allocation-free DPS150 frame encoder
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include <string.h>
+
+#include "dps150_encode.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *  GLOBAL VARIABLES
+ **********************/
+
+const uint8_t dps150_frame_get_all[DPS150_FRAME_U8_LEN] =
+    DPS150_FRAME_U8(CMD_GET, DPS150_REG_ALL, 0);
+
+const uint8_t dps150_frame_output_on[DPS150_FRAME_U8_LEN] =
+    DPS150_FRAME_U8(CMD_SET, DPS150_REG_OUTPUT, 1);
+
+const uint8_t dps150_frame_output_off[DPS150_FRAME_U8_LEN] =
+    DPS150_FRAME_U8(CMD_SET, DPS150_REG_OUTPUT, 0);
+
+const uint8_t dps150_frame_session_start[DPS150_FRAME_U8_LEN] =
+    DPS150_FRAME_U8(CMD_XXX_193, 0, 1);
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+size_t dps150_encode(uint8_t *out, size_t out_size, uint8_t header, uint8_t cmd,
+                     uint8_t type, const uint8_t *payload, uint8_t len)
+{
+    size_t total = (size_t)len + DPS150_FRAME_OVERHEAD;
+    uint8_t sum;
+    uint8_t i;
+
+    if (total > out_size) {
+        return 0;
+    }
+
+    out[0] = header;
+    out[1] = cmd;
+    out[2] = type;
+    out[3] = len;
+
+    sum = type + len;
+    for (i = 0; i < len; i++) {
+        out[4 + i] = payload[i];
+        sum += payload[i];
+    }
+
+    out[total - 1] = sum;
+
+    return total;
+}
+
+size_t dps150_encode_float(uint8_t *out, size_t out_size, uint8_t header, uint8_t cmd,
+                           uint8_t type, float value)
+{
+    uint8_t bytes[sizeof(float)];
+
+    memcpy(bytes, &value, sizeof(bytes));
+
+    return dps150_encode(out, out_size, header, cmd, type, bytes, sizeof(bytes));
+}
+
+size_t dps150_encode_get(uint8_t *out, size_t out_size, uint8_t type)
+{
+    static const uint8_t zero = 0;
+
+    return dps150_encode(out, out_size, HEADER_OUTPUT, CMD_GET, type, &zero, 1);
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
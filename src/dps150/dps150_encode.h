@@ -0,0 +1,100 @@
+/**
+ * @file dps150_encode.h
+ *
+ * Allocation-free DPS150 frame encoder
+ *
+ * Frames are built into storage provided by the caller, typically a
+ * slot of the serial I/O transmit pool. The frames which never change
+ * are constant tables, their checksum is computed at compile time.
+ *
+ */
+
+#ifndef DPS150_ENCODE_H
+#define DPS150_ENCODE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include <stddef.h>
+#include <stdint.h>
+
+#include "dps150_proto.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  GLOBAL VARIABLES
+ **********************/
+
+/* CMD_GET of the complete status block */
+extern const uint8_t dps150_frame_get_all[DPS150_FRAME_U8_LEN];
+
+/* Output enable and disable */
+extern const uint8_t dps150_frame_output_on[DPS150_FRAME_U8_LEN];
+extern const uint8_t dps150_frame_output_off[DPS150_FRAME_U8_LEN];
+
+/* Session start, sent once after the port is opened */
+extern const uint8_t dps150_frame_session_start[DPS150_FRAME_U8_LEN];
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Encode a frame
+ *
+ * @param out destination buffer
+ * @param out_size size of the destination buffer
+ * @param header HEADER_OUTPUT for commands, HEADER_INPUT for replies
+ * @param cmd the command
+ * @param type the register type
+ * @param payload the payload, may be NULL if len is 0
+ * @param len the payload length
+ * @return the frame length, 0 if it does not fit in out
+ */
+size_t dps150_encode(uint8_t *out, size_t out_size, uint8_t header, uint8_t cmd,
+                     uint8_t type, const uint8_t *payload, uint8_t len);
+
+/**
+ * Encode a command with a float payload - setpoints and limits
+ *
+ * @param out destination buffer
+ * @param out_size size of the destination buffer
+ * @param header HEADER_OUTPUT for commands, HEADER_INPUT for replies
+ * @param cmd the command
+ * @param type the register type
+ * @param value the value, sent in the byte order of the device (little endian)
+ * @return the frame length, 0 if it does not fit in out
+ */
+size_t dps150_encode_float(uint8_t *out, size_t out_size, uint8_t header, uint8_t cmd,
+                           uint8_t type, float value);
+
+/**
+ * Encode a CMD_GET request
+ *
+ * @param out destination buffer
+ * @param out_size size of the destination buffer
+ * @param type the register type to read
+ * @return the frame length, 0 if it does not fit in out
+ */
+size_t dps150_encode_get(uint8_t *out, size_t out_size, uint8_t type);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*DPS150_ENCODE_H*/
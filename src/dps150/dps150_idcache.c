@@ -0,0 +1,209 @@
+/**
+ * @file dps150_idcache.c
+ *
+ * Identity cache of the known devices
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <sys/stat.h>
+
+#include "port_watch.h"
+#include "dps150_probe.h"
+#include "dps150_idcache.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+#define IDCACHE_FILE_NAME "dps150-ids"
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+typedef struct {
+    char serial[PORT_WATCH_SERIAL_MAX];
+    char model[DPS150_PROBE_MODEL_MAX];
+} idcache_entry_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static int save(void);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/* Most recently stored first */
+static idcache_entry_t entries[DPS150_IDCACHE_MAX];
+static int entry_cnt;
+static char cache_path[PATH_MAX];
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+int dps150_idcache_load(const char *path)
+{
+    char line[PORT_WATCH_SERIAL_MAX + DPS150_PROBE_MODEL_MAX + 2];
+    const char *dir;
+    char *tab;
+    FILE *f;
+
+    entry_cnt = 0;
+
+    if (path == NULL) {
+        path = getenv("DPS150_ID_CACHE");
+    }
+
+    if (path != NULL) {
+        snprintf(cache_path, sizeof(cache_path), "%s", path);
+    } else if ((dir = getenv("XDG_CACHE_HOME")) != NULL && dir[0] != '\0') {
+        snprintf(cache_path, sizeof(cache_path), "%s/" IDCACHE_FILE_NAME, dir);
+    } else if ((dir = getenv("HOME")) != NULL) {
+        snprintf(cache_path, sizeof(cache_path), "%s/.cache/" IDCACHE_FILE_NAME, dir);
+    } else {
+        cache_path[0] = '\0';
+        return -1;
+    }
+
+    f = fopen(cache_path, "r");
+    if (f == NULL) {
+        return -1;
+    }
+
+    while (entry_cnt < DPS150_IDCACHE_MAX && fgets(line, sizeof(line), f) != NULL) {
+        line[strcspn(line, "\n")] = '\0';
+
+        tab = strchr(line, '\t');
+        if (tab == NULL || tab == line) {
+            continue;
+        }
+        *tab = '\0';
+
+        /* Overlong fields are cut, like when they were stored */
+        snprintf(entries[entry_cnt].serial, sizeof(entries[0].serial), "%.*s",
+                 (int)sizeof(entries[0].serial) - 1, line);
+        snprintf(entries[entry_cnt].model, sizeof(entries[0].model), "%.*s",
+                 (int)sizeof(entries[0].model) - 1, tab + 1);
+        entry_cnt++;
+    }
+
+    fclose(f);
+    return entry_cnt;
+}
+
+const char *dps150_idcache_lookup(const char *serial)
+{
+    int i;
+
+    if (serial[0] == '\0') {
+        return NULL;
+    }
+
+    for (i = 0; i < entry_cnt; i++) {
+        if (strcmp(entries[i].serial, serial) == 0) {
+            return entries[i].model;
+        }
+    }
+
+    return NULL;
+}
+
+int dps150_idcache_store(const char *serial, const char *model)
+{
+    idcache_entry_t entry;
+    int i;
+
+    if (serial[0] == '\0') {
+        return 0;
+    }
+
+    for (i = 0; i < entry_cnt; i++) {
+        if (strcmp(entries[i].serial, serial) == 0) {
+            break;
+        }
+    }
+
+    /* Known and already the most recent one: nothing to write */
+    if (i == 0 && entry_cnt > 0 && strcmp(entries[0].model, model) == 0) {
+        return 0;
+    }
+
+    snprintf(entry.serial, sizeof(entry.serial), "%s", serial);
+    snprintf(entry.model, sizeof(entry.model), "%s", model);
+
+    if (i == entry_cnt) {
+        /* New device, the oldest one falls off a full cache */
+        if (entry_cnt < DPS150_IDCACHE_MAX) {
+            entry_cnt++;
+        }
+        i = entry_cnt - 1;
+    }
+
+    memmove(&entries[1], &entries[0], (size_t)i * sizeof(entries[0]));
+    entries[0] = entry;
+
+    return save();
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Write the cache to a temporary file renamed over the previous one
+ *
+ * @return 0 on success, -1 on error
+ */
+static int save(void)
+{
+    char tmp[PATH_MAX + 8];
+    char dir[PATH_MAX];
+    char *slash;
+    FILE *f;
+    int i;
+
+    if (cache_path[0] == '\0') {
+        return -1;
+    }
+
+    /* ~/.cache may not exist yet */
+    snprintf(dir, sizeof(dir), "%s", cache_path);
+    slash = strrchr(dir, '/');
+    if (slash != NULL && slash != dir) {
+        *slash = '\0';
+        mkdir(dir, 0755);
+    }
+
+    snprintf(tmp, sizeof(tmp), "%s.tmp", cache_path);
+    f = fopen(tmp, "w");
+    if (f == NULL) {
+        perror(tmp);
+        return -1;
+    }
+
+    for (i = 0; i < entry_cnt; i++) {
+        fprintf(f, "%s\t%s\n", entries[i].serial, entries[i].model);
+    }
+
+    if (fclose(f) != 0 || rename(tmp, cache_path) != 0) {
+        perror(cache_path);
+        remove(tmp);
+        return -1;
+    }
+
+    return 0;
+}
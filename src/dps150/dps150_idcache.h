@@ -0,0 +1,70 @@
+/**
+ * @file dps150_idcache.h
+ *
+ * Identity cache of the known devices
+ *
+ * Maps the USB serial number of a port to the model name the device
+ * reported, so a port already known to be a DPS-150 can be connected
+ * at startup without probing. Stored as one "serial<TAB>model" line
+ * per device.
+ *
+ */
+
+#ifndef DPS150_IDCACHE_H
+#define DPS150_IDCACHE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/* Devices remembered, the least recently seen one is replaced */
+#define DPS150_IDCACHE_MAX 16
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Load the cache
+ * @param path the cache file, NULL for $DPS150_ID_CACHE, or
+ * dps150-ids in $XDG_CACHE_HOME or ~/.cache
+ * @return the number of devices loaded, -1 if the file cannot be read
+ */
+int dps150_idcache_load(const char *path);
+
+/**
+ * Look up a device
+ * @param serial the USB serial number
+ * @return the model name, NULL if the device is unknown
+ */
+const char *dps150_idcache_lookup(const char *serial);
+
+/**
+ * Remember a device and save the cache if it changed
+ * @param serial the USB serial number, ignored if empty
+ * @param model the model name the device reported
+ * @return 0 on success, -1 if the file cannot be written
+ */
+int dps150_idcache_store(const char *serial, const char *model);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*DPS150_IDCACHE_H*/
@@ -0,0 +1,165 @@
+/**
+ * @file dps150_parser.c
+ *
+ * Incremental DPS150 frame parser
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include <stdbool.h>
+#include <string.h>
+
+#include "dps150_parser.h"
+#include "dps150_regs.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+#define RING_MASK (DPS150_PARSER_RING_SIZE - 1)
+
+/* Host commands carry at most a float setpoint */
+#define HOST_PAYLOAD_MAX 4
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void scan(dps150_parser_t *parser);
+static bool cmd_valid(uint8_t cmd);
+static uint8_t payload_max(const dps150_parser_t *parser, uint8_t type);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/* Byte at an offset from the start of the candidate frame */
+#define AT(parser, offset) ((parser)->ring[(uint16_t)((parser)->tail + (offset)) & RING_MASK])
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void dps150_parser_init(dps150_parser_t *parser, uint8_t header,
+                        dps150_parser_frame_cb_t frame_cb, void *user_data)
+{
+    memset(parser, 0, sizeof(*parser));
+    parser->header = header;
+    parser->frame_cb = frame_cb;
+    parser->user_data = user_data;
+}
+
+void dps150_parser_reset(dps150_parser_t *parser)
+{
+    parser->tail = parser->head;
+}
+
+void dps150_parser_feed(dps150_parser_t *parser, const uint8_t *data, size_t len)
+{
+    const uint8_t *end = data + len;
+
+    /* The ring never holds more than one frame, scanning after every
+     * byte keeps it from overflowing */
+    while (data < end) {
+        parser->ring[parser->head++ & RING_MASK] = *data++;
+        scan(parser);
+    }
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Check the candidate frame at the tail of the ring, report it if it is
+ * complete and valid, reject it otherwise and retry from the next byte
+ * @param parser the parser
+ */
+static void scan(dps150_parser_t *parser)
+{
+    uint16_t avail;
+    uint8_t cmd;
+    uint8_t type;
+    uint8_t len;
+    uint8_t sum;
+    uint8_t i;
+
+    while ((avail = (uint16_t)(parser->head - parser->tail)) > 0) {
+        if (AT(parser, 0) != parser->header) {
+            parser->tail++;
+            parser->skipped++;
+            continue;
+        }
+
+        if (avail < 2) {
+            return;
+        }
+        cmd = AT(parser, 1);
+        if (!cmd_valid(cmd)) {
+            parser->tail++;
+            parser->skipped++;
+            continue;
+        }
+
+        if (avail < 4) {
+            return;
+        }
+        type = AT(parser, 2);
+        len = AT(parser, 3);
+        if (len > payload_max(parser, type)) {
+            parser->tail++;
+            parser->skipped++;
+            continue;
+        }
+
+        if (avail < (uint16_t)len + DPS150_FRAME_OVERHEAD) {
+            return;
+        }
+
+        sum = type + len;
+        for (i = 0; i < len; i++) {
+            parser->payload[i] = AT(parser, 4 + i);
+            sum += parser->payload[i];
+        }
+
+        if (sum != AT(parser, 4 + len)) {
+            /* The header was part of the data, the next frame may start inside it */
+            parser->tail++;
+            parser->checksum_errors++;
+            continue;
+        }
+
+        parser->tail += (uint16_t)len + DPS150_FRAME_OVERHEAD;
+        parser->frames++;
+        parser->frame_cb(cmd, type, parser->payload, len, parser->user_data);
+    }
+}
+
+static bool cmd_valid(uint8_t cmd)
+{
+    return cmd == CMD_GET || cmd == CMD_SET || cmd == CMD_XXX_193;
+}
+
+/**
+ * Get the longest payload a frame may carry
+ * @param parser the parser
+ * @param type the register type of the frame
+ * @return the length limit
+ */
+static uint8_t payload_max(const dps150_parser_t *parser, uint8_t type)
+{
+    if (parser->header == HEADER_OUTPUT) {
+        return HOST_PAYLOAD_MAX;
+    }
+
+    return dps150_regs_payload_max(type);
+}
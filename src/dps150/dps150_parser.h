@@ -0,0 +1,107 @@
+/**
+ * @file dps150_parser.h
+ *
+ * Incremental DPS150 frame parser
+ *
+ * The received bytes are kept in a fixed ring which always starts at
+ * the candidate frame: header, command, type, length, payload,
+ * checksum. Each byte only advances the checks of that candidate.
+ *
+ * Bytes can be fed in chunks of any size, frames may be split across
+ * chunks and a chunk may hold several frames - the callback is invoked
+ * for each one. A candidate with an unknown command, a length longer
+ * than its register can carry or a bad checksum is rejected and the
+ * scan restarts one byte after its header, so a false header inside
+ * the data never swallows the frames that follow it. Registers missing
+ * from the register table may carry any length, only their checksum
+ * rejects them. The ring holds one frame at most, the memory use is
+ * fixed.
+ *
+ */
+
+#ifndef DPS150_PARSER_H
+#define DPS150_PARSER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include <stddef.h>
+#include <stdint.h>
+
+#include "dps150_proto.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/* Power of two, larger than the longest frame */
+#define DPS150_PARSER_RING_SIZE 512
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/* Prototype of the function called for every valid frame */
+typedef void (*dps150_parser_frame_cb_t)(uint8_t cmd, uint8_t type,
+                                         const uint8_t *payload, uint8_t len,
+                                         void *user_data);
+
+typedef struct {
+    uint8_t header;             /* Header byte that starts a frame */
+    uint16_t head;              /* Free running write index */
+    uint16_t tail;              /* Free running index of the candidate frame */
+    uint8_t ring[DPS150_PARSER_RING_SIZE];
+    uint8_t payload[DPS150_PAYLOAD_MAX];    /* Contiguous copy passed to frame_cb */
+
+    dps150_parser_frame_cb_t frame_cb;
+    void *user_data;
+
+    /* Statistics */
+    uint32_t frames;            /* Valid frames */
+    uint32_t checksum_errors;   /* Candidates rejected because of a bad checksum */
+    uint32_t skipped;           /* Bytes skipped while looking for a valid frame start */
+} dps150_parser_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Initialize a parser
+ *
+ * @param parser the parser to initialize
+ * @param header HEADER_INPUT to parse device replies, HEADER_OUTPUT for host commands
+ * @param frame_cb called for each valid frame, the payload is only valid during the call
+ * @param user_data passed to frame_cb
+ */
+void dps150_parser_init(dps150_parser_t *parser, uint8_t header,
+                        dps150_parser_frame_cb_t frame_cb, void *user_data);
+
+/**
+ * Drop the buffered bytes, the statistics are kept
+ * @param parser the parser
+ */
+void dps150_parser_reset(dps150_parser_t *parser);
+
+/**
+ * Feed received bytes to the parser
+ *
+ * @param parser the parser
+ * @param data the received bytes
+ * @param len number of bytes
+ */
+void dps150_parser_feed(dps150_parser_t *parser, const uint8_t *data, size_t len);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*DPS150_PARSER_H*/
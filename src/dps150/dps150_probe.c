@@ -0,0 +1,376 @@
+/**
+ * @file dps150_probe.c
+ *
+ * Parallel DPS-150 detection
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include <unistd.h>
+#include <pthread.h>
+#include <poll.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+#include <termios.h>
+#include <sys/eventfd.h>
+
+#include "../lib/simulator_util.h"
+#include "dps150_parser.h"
+#include "dps150_encode.h"
+#include "dps150_regs.h"
+#include "dps150_probe.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/* The model name request is repeated until the deadline */
+#define PROBE_RESEND_MS 100
+
+#define PROBE_RX_CHUNK 256
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+typedef struct {
+    char path[DPS150_PROBE_PATH_MAX];
+    int fd;
+    dps150_parser_t parser;
+    bool answered;
+    char model[DPS150_PROBE_MODEL_MAX];
+} probe_port_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void *probe_thread(void *arg);
+static void send_request(probe_port_t *port);
+static void port_write(probe_port_t *port, const uint8_t *data, size_t len);
+static void frame_cb(uint8_t cmd, uint8_t type, const uint8_t *payload, uint8_t len,
+                     void *user_data);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+static probe_port_t ports[DPS150_PROBE_MAX];
+static uint32_t port_cnt;
+static uint32_t timeout_ms;
+
+static pthread_t thread;
+static bool thread_running = false;
+static bool cancel_requested;
+static int wake_fd = -1;
+static int event_fd = -1;
+
+/* Written by the thread, read after pthread_join */
+static dps150_probe_result_t result;
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+int dps150_probe_open(const char *path)
+{
+    struct termios options;
+    int fd = open(path, O_RDWR | O_NOCTTY | O_NONBLOCK | O_CLOEXEC);
+
+    if (fd < 0) {
+        return -1;
+    }
+
+    /* A pty or a file is accepted as is */
+    if (tcgetattr(fd, &options) == 0) {
+        cfsetispeed(&options, B115200);
+        cfsetospeed(&options, B115200);
+
+        options.c_cflag |= (CLOCAL | CREAD);
+        options.c_cflag &= ~(PARENB | CSTOPB | CSIZE);
+        options.c_cflag |= CS8 | CRTSCTS;
+        options.c_lflag &= ~(ICANON | ECHO | ECHOE | ISIG);
+        options.c_iflag &= ~(IXON | IXOFF | IXANY);
+        options.c_oflag &= ~OPOST;
+
+        tcsetattr(fd, TCSANOW, &options);
+    }
+
+    return fd;
+}
+
+int dps150_probe_start(const char *const *paths, uint32_t cnt, uint32_t timeout)
+{
+    uint32_t i;
+
+    if (thread_running || dps150_probe_get_event_fd() < 0) {
+        return -1;
+    }
+
+    wake_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (wake_fd < 0) {
+        perror("dps150_probe eventfd");
+        return -1;
+    }
+
+    port_cnt = cnt < DPS150_PROBE_MAX ? cnt : DPS150_PROBE_MAX;
+    for (i = 0; i < port_cnt; i++) {
+        snprintf(ports[i].path, sizeof(ports[i].path), "%s", paths[i]);
+        ports[i].fd = -1;
+    }
+
+    timeout_ms = timeout;
+    cancel_requested = false;
+
+    if (pthread_create(&thread, NULL, probe_thread, NULL) != 0) {
+        close(wake_fd);
+        wake_fd = -1;
+        return -1;
+    }
+
+    thread_running = true;
+    return 0;
+}
+
+bool dps150_probe_running(void)
+{
+    return thread_running;
+}
+
+int dps150_probe_get_event_fd(void)
+{
+    if (event_fd < 0) {
+        event_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (event_fd < 0) {
+            perror("dps150_probe eventfd");
+        }
+    }
+
+    return event_fd;
+}
+
+int dps150_probe_finish(dps150_probe_result_t *res)
+{
+    if (!thread_running) {
+        return -1;
+    }
+
+    pthread_join(thread, NULL);
+    thread_running = false;
+
+    close(wake_fd);
+    wake_fd = -1;
+
+    *res = result;
+    return res->fd >= 0 ? 0 : -1;
+}
+
+void dps150_probe_cancel(void)
+{
+    dps150_probe_result_t res;
+    uint64_t one = 1;
+    uint64_t count;
+
+    if (!thread_running) {
+        return;
+    }
+
+    __atomic_store_n(&cancel_requested, true, __ATOMIC_RELEASE);
+    if (write(wake_fd, &one, sizeof(one)) < 0) {
+        perror("dps150_probe_cancel");
+    }
+
+    if (dps150_probe_finish(&res) == 0) {
+        close(res.fd);
+    }
+
+    /* The thread signals its end even when cancelled, the event must not
+     * be taken for the end of the next probe */
+    if (read(event_fd, &count, sizeof(count)) < 0 && errno != EAGAIN) {
+        perror("dps150_probe_cancel");
+    }
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * The probe thread
+ *
+ * @description opens every port, then sleeps in poll(2) until a port
+ * has data, a request has to be repeated, the deadline passes or the
+ * probe is cancelled. Every port but the winner is closed on exit
+ */
+static void *probe_thread(void *arg)
+{
+    struct pollfd fds[DPS150_PROBE_MAX + 1];
+    uint8_t chunk[PROBE_RX_CHUNK];
+    probe_port_t *winner = NULL;
+    probe_port_t *port;
+    uint64_t start = get_monotonic_us();
+    uint64_t deadline = start + (uint64_t)timeout_ms * 1000u;
+    uint64_t resend = start;
+    uint64_t now;
+    uint64_t next;
+    ssize_t len;
+    uint32_t i;
+    uint64_t one = 1;
+
+    (void)arg;
+
+    for (i = 0; i < port_cnt; i++) {
+        port = &ports[i];
+        port->answered = false;
+        port->model[0] = '\0';
+        port->fd = dps150_probe_open(port->path);
+        dps150_parser_init(&port->parser, HEADER_INPUT, frame_cb, port);
+
+        port_write(port, dps150_frame_session_start, sizeof(dps150_frame_session_start));
+        fds[i].events = POLLIN;
+    }
+
+    fds[port_cnt].fd = wake_fd;
+    fds[port_cnt].events = POLLIN;
+
+    while (winner == NULL && !__atomic_load_n(&cancel_requested, __ATOMIC_ACQUIRE)) {
+        now = get_monotonic_us();
+        if (now >= deadline) {
+            break;
+        }
+
+        if (now >= resend) {
+            for (i = 0; i < port_cnt; i++) {
+                send_request(&ports[i]);
+            }
+            resend = now + PROBE_RESEND_MS * 1000u;
+        }
+
+        /* poll(2) ignores the negative descriptors of closed ports */
+        for (i = 0; i < port_cnt; i++) {
+            fds[i].fd = ports[i].fd;
+        }
+
+        next = resend < deadline ? resend : deadline;
+        if (poll(fds, port_cnt + 1, (int)((next - now + 999) / 1000)) < 0 && errno != EINTR) {
+            break;
+        }
+
+        for (i = 0; i < port_cnt && winner == NULL; i++) {
+            port = &ports[i];
+
+            if (fds[i].revents & (POLLERR | POLLHUP | POLLNVAL)) {
+                /* Not a usable port, stop polling it */
+                close(port->fd);
+                port->fd = -1;
+                continue;
+            }
+
+            if (fds[i].revents & POLLIN) {
+                while ((len = read(port->fd, chunk, sizeof(chunk))) > 0 && !port->answered) {
+                    dps150_parser_feed(&port->parser, chunk, (size_t)len);
+                }
+                if (port->answered) {
+                    winner = port;
+                } else if (len == 0 || (len < 0 && errno != EAGAIN)) {
+                    /* End of file, e.g. not a terminal */
+                    close(port->fd);
+                    port->fd = -1;
+                }
+            }
+        }
+    }
+
+    memset(&result, 0, sizeof(result));
+    result.fd = -1;
+
+    for (i = 0; i < port_cnt; i++) {
+        port = &ports[i];
+
+        if (port == winner) {
+            result.fd = port->fd;
+            memcpy(result.path, port->path, sizeof(result.path));
+            memcpy(result.model, port->model, sizeof(result.model));
+            result.elapsed_ms = (uint32_t)((get_monotonic_us() - start) / 1000u);
+
+            /* The serial I/O thread starts from a clean input queue */
+            tcflush(port->fd, TCIFLUSH);
+        } else if (port->fd >= 0) {
+            close(port->fd);
+        }
+        port->fd = -1;
+    }
+
+    if (write(event_fd, &one, sizeof(one)) < 0) {
+        perror("dps150_probe signal");
+    }
+
+    return NULL;
+}
+
+/**
+ * Ask a port for the model name
+ *
+ * @param port the port, skipped if it is not open
+ */
+static void send_request(probe_port_t *port)
+{
+    uint8_t frame[DPS150_FRAME_U8_LEN];
+    size_t len;
+
+    len = dps150_encode_get(frame, sizeof(frame), dps150_regs[DPS150_FIELD_MODEL].reg);
+    port_write(port, frame, len);
+}
+
+/**
+ * Write to a port, it is closed if the write fails
+ *
+ * @param port the port, skipped if it is not open
+ * @param data the bytes
+ * @param len the number of bytes
+ */
+static void port_write(probe_port_t *port, const uint8_t *data, size_t len)
+{
+    if (port->fd < 0) {
+        return;
+    }
+
+    /* A full output queue only delays the answer to the next request */
+    if (write(port->fd, data, len) < 0 && errno != EAGAIN) {
+        close(port->fd);
+        port->fd = -1;
+    }
+}
+
+/**
+ * Keep the model name reply of a port
+ *
+ * @param cmd the command of the frame
+ * @param type the register type
+ * @param payload the payload
+ * @param len the payload length
+ * @param user_data the port
+ */
+static void frame_cb(uint8_t cmd, uint8_t type, const uint8_t *payload, uint8_t len,
+                     void *user_data)
+{
+    probe_port_t *port = user_data;
+
+    if (cmd != CMD_GET || type != dps150_regs[DPS150_FIELD_MODEL].reg) {
+        return;
+    }
+
+    if (len >= sizeof(port->model)) {
+        len = sizeof(port->model) - 1;
+    }
+    memcpy(port->model, payload, len);
+    port->model[len] = '\0';
+    port->answered = true;
+}
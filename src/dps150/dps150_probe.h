@@ -0,0 +1,106 @@
+/**
+ * @file dps150_probe.h
+ *
+ * Parallel DPS-150 detection
+ *
+ * A thread opens every candidate port at once, asks each for its model
+ * name (register 222) and keeps the first port that answers, so the
+ * detection takes one round trip rather than one timeout per port.
+ * The winning port is handed over open, ready for serial_io_start.
+ *
+ */
+
+#ifndef DPS150_PROBE_H
+#define DPS150_PROBE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include <stdint.h>
+#include <stdbool.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/* Ports probed at once */
+#define DPS150_PROBE_MAX 17
+
+#define DPS150_PROBE_PATH_MAX 128
+#define DPS150_PROBE_MODEL_MAX 32
+
+/* Default time allowed to the devices to answer */
+#define DPS150_PROBE_TIMEOUT_MS 1500
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+typedef struct {
+    int fd;                                 /* The open port, -1 if none answered */
+    char path[DPS150_PROBE_PATH_MAX];
+    char model[DPS150_PROBE_MODEL_MAX];     /* Model name reported by the device */
+    uint32_t elapsed_ms;                    /* Time from the start to the answer */
+} dps150_probe_result_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Open a port with the settings of the DPS-150
+ * @description 115200 baud 8N1, raw and non-blocking
+ * @param path the device path
+ * @return the file descriptor, -1 on error with errno set
+ */
+int dps150_probe_open(const char *path);
+
+/**
+ * Start probing ports in the background
+ * @param paths the device paths, copied
+ * @param cnt the number of paths, at most DPS150_PROBE_MAX are probed
+ * @param timeout_ms the time allowed to the devices to answer
+ * @return 0 on success, -1 if a probe is already running or on error
+ */
+int dps150_probe_start(const char *const *paths, uint32_t cnt, uint32_t timeout_ms);
+
+/**
+ * Tell whether a probe was started and not finished yet
+ * @return true if dps150_probe_finish has to be called
+ */
+bool dps150_probe_running(void);
+
+/**
+ * Get a file descriptor that becomes readable when the probe is over
+ * @description created on the first call, read its counter then call
+ * dps150_probe_finish
+ * @return the eventfd, -1 if it cannot be created
+ */
+int dps150_probe_get_event_fd(void);
+
+/**
+ * Wait for the probe thread and get its result
+ * @param res filled with the result, the caller owns res->fd
+ * @return 0 if a device answered, -1 otherwise
+ */
+int dps150_probe_finish(dps150_probe_result_t *res);
+
+/**
+ * Stop a running probe, every port it opened is closed and its pending
+ * event is discarded
+ */
+void dps150_probe_cancel(void);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*DPS150_PROBE_H*/
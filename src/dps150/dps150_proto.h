@@ -0,0 +1,77 @@
+/**
+ * @file dps150_proto.h
+ *
+ * Constants of the DPS150 serial protocol
+ *
+ * A frame is: header, command, register type, payload length,
+ * payload, checksum. The checksum is the low byte of the sum of the
+ * register type, the length and every payload byte.
+ *
+ */
+
+#ifndef DPS150_PROTO_H
+#define DPS150_PROTO_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+
+/*********************
+ *      DEFINES
+ *********************/
+
+#define HEADER_OUTPUT 0xF1      /* Host -> device */
+#define HEADER_INPUT  0xf0      /* Device -> host */
+
+#define CMD_GET       0xa1
+#define CMD_SET       0xb1
+#define CMD_XXX_193   0xC1      /* Session start, sent once after opening the port */
+
+/* Header, command, type, length and checksum */
+#define DPS150_FRAME_OVERHEAD 5
+
+/* The length field is a single byte */
+#define DPS150_PAYLOAD_MAX 255
+
+#define DPS150_FRAME_MAX (DPS150_PAYLOAD_MAX + DPS150_FRAME_OVERHEAD)
+
+/* Registers written by the application */
+#define DPS150_REG_SET_VOLTAGE  193
+#define DPS150_REG_SET_CURRENT  194
+#define DPS150_REG_OUTPUT       219
+#define DPS150_REG_ALL          255
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**
+ * Initializer of a host frame with a one byte payload - the checksum
+ * is folded by the compiler, use it for frames that never change
+ * @param cmd the command
+ * @param type the register type
+ * @param value the payload byte
+ */
+#define DPS150_FRAME_U8(cmd, type, value) \
+    { HEADER_OUTPUT, (cmd), (type), 1, (value), (uint8_t)((type) + 1 + (value)) }
+
+/* Size of a frame built with DPS150_FRAME_U8 */
+#define DPS150_FRAME_U8_LEN (DPS150_FRAME_OVERHEAD + 1)
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*DPS150_PROTO_H*/
@@ -0,0 +1,284 @@
+/**
+ * @file dps150_regs.c
+ *
+ * DPS150 register map and typed status decoder
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include <string.h>
+
+#include "dps150_regs.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void decode_field(dps150_status_t *status, const dps150_reg_desc_t *desc,
+                         const uint8_t *src, uint8_t avail);
+static int scale_decimals(uint16_t scale);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+#define REG_F32(field, member, nm, un, sc, rg, roff, aoff) \
+    [field] = { nm, un, sc, DPS150_KIND_F32, rg, roff, aoff, \
+                offsetof(dps150_status_t, member), sizeof(float) }
+
+#define REG_U8(field, member, nm, rg, aoff) \
+    [field] = { nm, "", 1, DPS150_KIND_U8, rg, 0, aoff, \
+                offsetof(dps150_status_t, member), sizeof(uint8_t) }
+
+#define REG_STR(field, member, nm, rg) \
+    [field] = { nm, "", 1, DPS150_KIND_STR, rg, 0, -1, \
+                offsetof(dps150_status_t, member), DPS150_STR_MAX }
+
+#define REG_GROUP(n, num) \
+    REG_F32(DPS150_FIELD_GROUP1_VOLTAGE + 2 * (n), group[n].voltage, "Group " num " voltage", "V", \
+            100, 197 + 2 * (n), 0, 28 + 8 * (n)), \
+    REG_F32(DPS150_FIELD_GROUP1_CURRENT + 2 * (n), group[n].current, "Group " num " current", "A", \
+            100, 198 + 2 * (n), 0, 32 + 8 * (n))
+
+/**********************
+ *  GLOBAL VARIABLES
+ **********************/
+
+const dps150_reg_desc_t dps150_regs[_DPS150_FIELD_CNT] = {
+    REG_F32(DPS150_FIELD_INPUT_VOLTAGE, input_voltage, "Input voltage", "V", 100, 192, 0, 0),
+    REG_F32(DPS150_FIELD_SET_VOLTAGE, set_voltage, "Set voltage", "V", 100,
+            DPS150_REG_SET_VOLTAGE, 0, 4),
+    REG_F32(DPS150_FIELD_SET_CURRENT, set_current, "Set current", "A", 100,
+            DPS150_REG_SET_CURRENT, 0, 8),
+    REG_F32(DPS150_FIELD_OUT_VOLTAGE, out_voltage, "Output voltage", "V", 100, 195, 0, 12),
+    REG_F32(DPS150_FIELD_OUT_CURRENT, out_current, "Output current", "A", 100, 195, 4, 16),
+    REG_F32(DPS150_FIELD_OUT_POWER, out_power, "Output power", "W", 100, 195, 8, 20),
+    REG_F32(DPS150_FIELD_TEMPERATURE, temperature, "Temperature", "C", 10, 196, 0, 24),
+    REG_GROUP(0, "1"),
+    REG_GROUP(1, "2"),
+    REG_GROUP(2, "3"),
+    REG_GROUP(3, "4"),
+    REG_GROUP(4, "5"),
+    REG_GROUP(5, "6"),
+    REG_F32(DPS150_FIELD_OVP, ovp, "OVP", "V", 100, 209, 0, 76),
+    REG_F32(DPS150_FIELD_OCP, ocp, "OCP", "A", 100, 210, 0, 80),
+    REG_F32(DPS150_FIELD_OPP, opp, "OPP", "W", 100, 211, 0, 84),
+    REG_F32(DPS150_FIELD_OTP, otp, "OTP", "C", 100, 212, 0, 88),
+    REG_F32(DPS150_FIELD_LVP, lvp, "LVP", "V", 100, 213, 0, 92),
+    REG_U8(DPS150_FIELD_BRIGHTNESS, brightness, "Brightness", 214, 96),
+    REG_U8(DPS150_FIELD_VOLUME, volume, "Volume", 215, 97),
+    REG_U8(DPS150_FIELD_METERING, metering, "Metering", 216, 98),
+    REG_F32(DPS150_FIELD_CAPACITY, capacity, "Output capacity", "Ah", 1000, 217, 0, 99),
+    REG_F32(DPS150_FIELD_ENERGY, energy, "Output energy", "Wh", 1000, 218, 0, 103),
+    REG_U8(DPS150_FIELD_OUTPUT, output, "Output", DPS150_REG_OUTPUT, 107),
+    REG_U8(DPS150_FIELD_PROTECTION, protection, "Protection", 220, 108),
+    REG_U8(DPS150_FIELD_MODE, mode, "Mode", 221, 109),
+    REG_F32(DPS150_FIELD_LIMIT_VOLTAGE, limit_voltage, "Upper limit voltage", "V", 100, 226, 0, 111),
+    REG_F32(DPS150_FIELD_LIMIT_CURRENT, limit_current, "Upper limit current", "A", 100, 227, 0, 115),
+    REG_STR(DPS150_FIELD_MODEL, model, "Model name", 222),
+    REG_STR(DPS150_FIELD_HW_VERSION, hw_version, "Hardware version", 223),
+    REG_STR(DPS150_FIELD_FW_VERSION, fw_version, "Firmware version", 224),
+};
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+uint64_t dps150_regs_decode(dps150_status_t *status, uint8_t type, const uint8_t *payload,
+                            uint8_t len)
+{
+    const dps150_reg_desc_t *desc;
+    uint64_t mask = 0;
+    uint32_t i;
+
+    for (i = 0; i < _DPS150_FIELD_CNT; i++) {
+        desc = &dps150_regs[i];
+
+        if (type == DPS150_REG_ALL) {
+            if (desc->all_offset < 0 || desc->all_offset + desc->size > len) {
+                continue;
+            }
+            decode_field(status, desc, payload + desc->all_offset, desc->size);
+        } else {
+            if (desc->reg != type || desc->reg_offset >= len) {
+                continue;
+            }
+            if (desc->kind != DPS150_KIND_STR && desc->reg_offset + desc->size > len) {
+                continue;
+            }
+            decode_field(status, desc, payload + desc->reg_offset, len - desc->reg_offset);
+        }
+
+        mask |= DPS150_FIELD_BIT(i);
+    }
+
+    return mask;
+}
+
+uint8_t dps150_regs_encode(const dps150_status_t *status, uint8_t type, uint8_t *payload)
+{
+    const dps150_reg_desc_t *desc;
+    const uint8_t *src;
+    size_t offset;
+    size_t size;
+    size_t len = 0;
+    uint32_t i;
+
+    for (i = 0; i < _DPS150_FIELD_CNT; i++) {
+        desc = &dps150_regs[i];
+        src = (const uint8_t *)status + desc->status_offset;
+
+        if (type == DPS150_REG_ALL) {
+            if (desc->all_offset < 0) {
+                continue;
+            }
+            offset = desc->all_offset;
+        } else if (desc->reg == type) {
+            offset = desc->reg_offset;
+        } else {
+            continue;
+        }
+
+        /* Strings are sent without their terminator */
+        size = desc->kind == DPS150_KIND_STR ? strnlen((const char *)src, desc->size) : desc->size;
+        if (offset + size > DPS150_PAYLOAD_MAX) {
+            continue;
+        }
+
+        /* Gaps between the fields stay zero */
+        if (offset > len) {
+            memset(payload + len, 0, offset - len);
+        }
+        memcpy(payload + offset, src, size);
+        if (offset + size > len) {
+            len = offset + size;
+        }
+    }
+
+    return (uint8_t)len;
+}
+
+uint64_t dps150_regs_fields_of(uint8_t type)
+{
+    uint64_t mask = 0;
+    uint32_t i;
+
+    for (i = 0; i < _DPS150_FIELD_CNT; i++) {
+        if (type == DPS150_REG_ALL ? dps150_regs[i].all_offset >= 0 : dps150_regs[i].reg == type) {
+            mask |= DPS150_FIELD_BIT(i);
+        }
+    }
+
+    return mask;
+}
+
+uint8_t dps150_regs_payload_max(uint8_t type)
+{
+    const dps150_reg_desc_t *desc;
+    uint32_t max = 0;
+    uint32_t i;
+
+    /* The status block is longer than the fields it is known to carry */
+    if (type == DPS150_REG_ALL) {
+        return DPS150_PAYLOAD_MAX;
+    }
+
+    for (i = 0; i < _DPS150_FIELD_CNT; i++) {
+        desc = &dps150_regs[i];
+        if (desc->reg == type && desc->reg_offset + desc->size > max) {
+            max = desc->reg_offset + desc->size;
+        }
+    }
+
+    /* A register missing from the table is only bounded by the frame, the
+     * checksum rejects a false header of that type */
+    return max == 0 ? DPS150_PAYLOAD_MAX : (uint8_t)max;
+}
+
+float dps150_regs_get_float(const dps150_status_t *status, dps150_field_t field)
+{
+    const dps150_reg_desc_t *desc = &dps150_regs[field];
+    const uint8_t *src = (const uint8_t *)status + desc->status_offset;
+    float value;
+
+    if (desc->kind == DPS150_KIND_U8) {
+        return (float)src[0];
+    }
+
+    memcpy(&value, src, sizeof(value));
+    return value;
+}
+
+void dps150_regs_dump(const dps150_status_t *status, uint64_t mask, FILE *out)
+{
+    const dps150_reg_desc_t *desc;
+    uint32_t i;
+
+    for (i = 0; i < _DPS150_FIELD_CNT; i++) {
+        if ((mask & DPS150_FIELD_BIT(i)) == 0) {
+            continue;
+        }
+
+        desc = &dps150_regs[i];
+        if (desc->kind == DPS150_KIND_STR) {
+            fprintf(out, "%s: %s\n", desc->name,
+                    (const char *)status + desc->status_offset);
+        } else {
+            fprintf(out, "%s: %.*f %s\n", desc->name, scale_decimals(desc->scale),
+                    dps150_regs_get_float(status, (dps150_field_t)i), desc->unit);
+        }
+    }
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Copy one field from the payload into the status
+ * @param status the status
+ * @param desc the field descriptor
+ * @param src the field in the payload
+ * @param avail the bytes available at src, only used for strings
+ */
+static void decode_field(dps150_status_t *status, const dps150_reg_desc_t *desc,
+                         const uint8_t *src, uint8_t avail)
+{
+    uint8_t *dst = (uint8_t *)status + desc->status_offset;
+    size_t n;
+
+    if (desc->kind == DPS150_KIND_STR) {
+        n = avail < desc->size - 1 ? avail : (size_t)desc->size - 1;
+        memcpy(dst, src, n);
+        memset(dst + n, 0, desc->size - n);
+        return;
+    }
+
+    /* The device and every supported host are little endian */
+    memcpy(dst, src, desc->size);
+}
+
+static int scale_decimals(uint16_t scale)
+{
+    int decimals = 0;
+
+    while (scale >= 10) {
+        scale /= 10;
+        decimals++;
+    }
+
+    return decimals;
+}
@@ -0,0 +1,222 @@
+/**
+ * @file dps150_regs.h
+ *
+ * DPS150 register map and typed status decoder
+ *
+ * Every field reported by the device is described once in a static
+ * table: where it is found in the 255 status block, which single
+ * register reply carries it, its type, unit and display scale. Replies
+ * are decoded in one pass over that table into a dps150_status_t.
+ *
+ */
+
+#ifndef DPS150_REGS_H
+#define DPS150_REGS_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include "dps150_proto.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+#define DPS150_GROUP_CNT 6
+
+/* Model name and version strings, including the terminator */
+#define DPS150_STR_MAX 32
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/* Field identifiers, also the bit index in a field mask */
+typedef enum {
+    DPS150_FIELD_INPUT_VOLTAGE = 0,
+    DPS150_FIELD_SET_VOLTAGE,
+    DPS150_FIELD_SET_CURRENT,
+    DPS150_FIELD_OUT_VOLTAGE,
+    DPS150_FIELD_OUT_CURRENT,
+    DPS150_FIELD_OUT_POWER,
+    DPS150_FIELD_TEMPERATURE,
+    DPS150_FIELD_GROUP1_VOLTAGE,
+    DPS150_FIELD_GROUP1_CURRENT,
+    DPS150_FIELD_GROUP2_VOLTAGE,
+    DPS150_FIELD_GROUP2_CURRENT,
+    DPS150_FIELD_GROUP3_VOLTAGE,
+    DPS150_FIELD_GROUP3_CURRENT,
+    DPS150_FIELD_GROUP4_VOLTAGE,
+    DPS150_FIELD_GROUP4_CURRENT,
+    DPS150_FIELD_GROUP5_VOLTAGE,
+    DPS150_FIELD_GROUP5_CURRENT,
+    DPS150_FIELD_GROUP6_VOLTAGE,
+    DPS150_FIELD_GROUP6_CURRENT,
+    DPS150_FIELD_OVP,
+    DPS150_FIELD_OCP,
+    DPS150_FIELD_OPP,
+    DPS150_FIELD_OTP,
+    DPS150_FIELD_LVP,
+    DPS150_FIELD_BRIGHTNESS,
+    DPS150_FIELD_VOLUME,
+    DPS150_FIELD_METERING,
+    DPS150_FIELD_CAPACITY,
+    DPS150_FIELD_ENERGY,
+    DPS150_FIELD_OUTPUT,
+    DPS150_FIELD_PROTECTION,
+    DPS150_FIELD_MODE,
+    DPS150_FIELD_LIMIT_VOLTAGE,
+    DPS150_FIELD_LIMIT_CURRENT,
+    DPS150_FIELD_MODEL,
+    DPS150_FIELD_HW_VERSION,
+    DPS150_FIELD_FW_VERSION,
+    _DPS150_FIELD_CNT
+} dps150_field_t;
+
+typedef enum {
+    DPS150_KIND_F32,        /* IEEE 754 float, little endian */
+    DPS150_KIND_U8,
+    DPS150_KIND_STR,        /* Whole payload, not terminated on the wire */
+} dps150_kind_t;
+
+typedef enum {
+    DPS150_PROTECTION_NONE = 0,
+    DPS150_PROTECTION_OVP,
+    DPS150_PROTECTION_OCP,
+    DPS150_PROTECTION_OPP,
+    DPS150_PROTECTION_OTP,
+    DPS150_PROTECTION_LVP,
+    DPS150_PROTECTION_REP,
+} dps150_protection_t;
+
+/* Decoded device registers - fields are native values, never text */
+typedef struct __attribute__((packed)) {
+    float input_voltage;
+    float set_voltage;
+    float set_current;
+    float out_voltage;
+    float out_current;
+    float out_power;
+    float temperature;
+    struct __attribute__((packed)) {
+        float voltage;
+        float current;
+    } group[DPS150_GROUP_CNT];
+    float ovp;
+    float ocp;
+    float opp;
+    float otp;
+    float lvp;
+    uint8_t brightness;
+    uint8_t volume;
+    uint8_t metering;       /* 0: open, 1: closed */
+    float capacity;         /* Ah */
+    float energy;           /* Wh */
+    uint8_t output;         /* 0: off, 1: on */
+    uint8_t protection;     /* dps150_protection_t */
+    uint8_t mode;           /* 0: CC, 1: CV */
+    float limit_voltage;
+    float limit_current;
+    char model[DPS150_STR_MAX];
+    char hw_version[DPS150_STR_MAX];
+    char fw_version[DPS150_STR_MAX];
+} dps150_status_t;
+
+/* Register descriptor */
+typedef struct {
+    const char *name;
+    const char *unit;
+    uint16_t scale;         /* Fixed point display scale, 100 shows two decimals */
+    uint8_t kind;           /* dps150_kind_t */
+    uint8_t reg;            /* Single register reply carrying the field, 0 if none */
+    uint8_t reg_offset;     /* Offset in that reply */
+    int16_t all_offset;     /* Offset in the DPS150_REG_ALL block, -1 if absent */
+    uint16_t status_offset; /* Offset in dps150_status_t */
+    uint16_t size;          /* Size in dps150_status_t */
+} dps150_reg_desc_t;
+
+/**********************
+ *  GLOBAL VARIABLES
+ **********************/
+
+/* Indexed by dps150_field_t */
+extern const dps150_reg_desc_t dps150_regs[_DPS150_FIELD_CNT];
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Decode a CMD_GET reply into the status
+ *
+ * @param status the status to update, fields absent from the reply are left untouched
+ * @param type the register type of the reply
+ * @param payload the payload
+ * @param len the payload length
+ * @return the mask of the decoded fields (bit n is dps150_field_t n), 0 for
+ * an unknown register or a short payload
+ */
+uint64_t dps150_regs_decode(dps150_status_t *status, uint8_t type, const uint8_t *payload,
+                            uint8_t len);
+
+/**
+ * Encode the payload of a CMD_GET reply from the status - the device side
+ * of dps150_regs_decode, used by the emulator
+ *
+ * @param status the status
+ * @param type the register type
+ * @param payload destination, DPS150_PAYLOAD_MAX bytes
+ * @return the payload length, 0 for an unknown register
+ */
+uint8_t dps150_regs_encode(const dps150_status_t *status, uint8_t type, uint8_t *payload);
+
+/**
+ * Get the fields carried by a register reply
+ * @param type the register type
+ * @return the field mask, 0 for an unknown register
+ */
+uint64_t dps150_regs_fields_of(uint8_t type);
+
+/**
+ * Get the longest payload a CMD_GET reply of a register may carry
+ * @param type the register type
+ * @return the length limit, DPS150_PAYLOAD_MAX for the status block and
+ * for an unknown register
+ */
+uint8_t dps150_regs_payload_max(uint8_t type);
+
+/**
+ * Read a numeric field as a float - U8 fields are converted
+ * @param status the status
+ * @param field the field, must not be a string
+ * @return the value
+ */
+float dps150_regs_get_float(const dps150_status_t *status, dps150_field_t field);
+
+/**
+ * Print the fields of a mask with their name and unit - diagnostics only
+ * @param status the status
+ * @param mask the fields to print
+ * @param out the stream to print to
+ */
+void dps150_regs_dump(const dps150_status_t *status, uint64_t mask, FILE *out);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#define DPS150_FIELD_BIT(field) (UINT64_C(1) << (field))
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*DPS150_REGS_H*/
@@ -0,0 +1,252 @@
+/**
+ * @file dps150_sched.c
+ *
+ * Adaptive per-register polling scheduler
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include <string.h>
+
+#include "dps150_regs.h"
+#include "dps150_sched.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/* Base periods between two reads of a register read once, until it answers */
+#define ONCE_RETRY 20
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/* Periods in multiples of the base period */
+typedef struct {
+    uint8_t reg;
+    uint8_t fast;       /* Output on, value moving */
+    uint8_t slow;       /* Output on, value steady */
+    uint8_t idle;       /* Output off */
+} sched_rate_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static dps150_sched_entry_t *find_entry(dps150_sched_t *sched, uint8_t reg);
+static uint64_t period_of(const dps150_sched_t *sched, uint8_t mul);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/* A zero fast rate marks a register read once after connecting */
+static const sched_rate_t rates[DPS150_SCHED_ENTRY_CNT] = {
+    { 195,   1,   4,  10 },     /* Output voltage, current, power */
+    { 192,   4,  20,  20 },     /* Input voltage */
+    { 196,   5,  20,  40 },     /* Temperature */
+    { DPS150_REG_OUTPUT,  5,  10,  10 },
+    { 220,   5,  10,  20 },     /* Protection state */
+    { 221,   5,  10,  20 },     /* CC/CV mode */
+    { 217,  10,  20, 100 },     /* Output capacity */
+    { 218,  10,  20, 100 },     /* Output energy */
+    { DPS150_REG_ALL, 100, 100, 100 },  /* Presets, limits and settings */
+    { 222,   0,   0,   0 },     /* Model name */
+    { 223,   0,   0,   0 },     /* Hardware version */
+    { 224,   0,   0,   0 },     /* Firmware version */
+};
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void dps150_sched_init(dps150_sched_t *sched, uint32_t base_ms, uint64_t now_us)
+{
+    dps150_sched_entry_t *entry;
+    uint32_t i;
+
+    memset(sched, 0, sizeof(*sched));
+    sched->base_us = (uint64_t)base_ms * 1000u;
+
+    for (i = 0; i < DPS150_SCHED_ENTRY_CNT; i++) {
+        entry = &sched->entries[i];
+        entry->reg = rates[i].reg;
+        entry->once = rates[i].fast == 0;
+        entry->period_us = period_of(sched, rates[i].idle);
+        entry->next_us = now_us;
+    }
+}
+
+void dps150_sched_restart(dps150_sched_t *sched, uint64_t now_us)
+{
+    uint32_t i;
+
+    for (i = 0; i < DPS150_SCHED_ENTRY_CNT; i++) {
+        /* A register read once is read again only if it never answered */
+        if (!sched->entries[i].once || sched->entries[i].next_us != DPS150_SCHED_NO_DEADLINE) {
+            sched->entries[i].next_us = now_us;
+        }
+    }
+}
+
+void dps150_sched_set_base(dps150_sched_t *sched, uint32_t base_ms)
+{
+    uint32_t i;
+
+    if (base_ms == 0) {
+        return;
+    }
+
+    for (i = 0; i < DPS150_SCHED_ENTRY_CNT; i++) {
+        sched->entries[i].period_us = sched->entries[i].period_us * base_ms * 1000u / sched->base_us;
+    }
+
+    sched->base_us = (uint64_t)base_ms * 1000u;
+}
+
+int dps150_sched_demand(dps150_sched_t *sched, uint8_t reg)
+{
+    dps150_sched_entry_t *entry = find_entry(sched, reg);
+
+    if (entry == NULL) {
+        return -1;
+    }
+
+    entry->demand = true;
+    return 0;
+}
+
+uint8_t dps150_sched_next(dps150_sched_t *sched, uint64_t now_us)
+{
+    dps150_sched_entry_t *entry;
+    dps150_sched_entry_t *best = NULL;
+    uint64_t best_due = UINT64_MAX;
+    uint64_t due;
+    uint32_t i;
+
+    for (i = 0; i < DPS150_SCHED_ENTRY_CNT; i++) {
+        entry = &sched->entries[i];
+        due = entry->demand ? 0 : entry->next_us;
+
+        /* The most overdue register goes first, the table order breaks ties */
+        if (due <= now_us && due < best_due) {
+            best = entry;
+            best_due = due;
+        }
+    }
+
+    if (best == NULL) {
+        return 0;
+    }
+
+    best->demand = false;
+    best->next_us = now_us + (best->once ? period_of(sched, ONCE_RETRY) : best->period_us);
+    best->polls++;
+
+    return best->reg;
+}
+
+uint64_t dps150_sched_next_deadline(const dps150_sched_t *sched)
+{
+    uint64_t due = DPS150_SCHED_NO_DEADLINE;
+    uint32_t i;
+
+    for (i = 0; i < DPS150_SCHED_ENTRY_CNT; i++) {
+        if (sched->entries[i].demand) {
+            return 0;
+        }
+        if (sched->entries[i].next_us < due) {
+            due = sched->entries[i].next_us;
+        }
+    }
+
+    return due;
+}
+
+void dps150_sched_on_reply(dps150_sched_t *sched, uint8_t type, const uint8_t *payload,
+                           uint8_t len)
+{
+    const dps150_reg_desc_t *output = &dps150_regs[DPS150_FIELD_OUTPUT];
+    dps150_sched_entry_t *entry;
+    uint32_t index;
+    uint8_t sig_len;
+    bool moving;
+    bool output_on = sched->output_on;
+    uint32_t i;
+
+    if (type == output->reg && len > output->reg_offset) {
+        output_on = payload[output->reg_offset] != 0;
+    } else if (type == DPS150_REG_ALL && len > output->all_offset) {
+        output_on = payload[output->all_offset] != 0;
+    }
+
+    if (output_on != sched->output_on) {
+        sched->output_on = output_on;
+
+        /* Start over from the fast or the idle rates, measurements first */
+        for (i = 0; i < DPS150_SCHED_ENTRY_CNT; i++) {
+            entry = &sched->entries[i];
+            if (!entry->once) {
+                entry->period_us = period_of(sched, output_on ? rates[i].fast : rates[i].idle);
+                entry->demand = output_on && rates[i].fast < rates[i].slow;
+            }
+        }
+    }
+
+    entry = find_entry(sched, type);
+    if (entry == NULL) {
+        return;
+    }
+
+    /* Read once: the retries stop with the first reply */
+    if (entry->once) {
+        entry->next_us = DPS150_SCHED_NO_DEADLINE;
+        return;
+    }
+    index = (uint32_t)(entry - sched->entries);
+
+    sig_len = len < DPS150_SCHED_SIG_SIZE ? len : DPS150_SCHED_SIG_SIZE;
+    moving = sig_len != entry->sig_len || memcmp(entry->sig, payload, sig_len) != 0;
+    memcpy(entry->sig, payload, sig_len);
+    entry->sig_len = sig_len;
+
+    if (!sched->output_on) {
+        entry->period_us = period_of(sched, rates[index].idle);
+    } else if (moving) {
+        entry->period_us = period_of(sched, rates[index].fast);
+    } else {
+        /* Steady: back off towards the slow period */
+        entry->period_us *= 2;
+        if (entry->period_us > period_of(sched, rates[index].slow)) {
+            entry->period_us = period_of(sched, rates[index].slow);
+        }
+    }
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static dps150_sched_entry_t *find_entry(dps150_sched_t *sched, uint8_t reg)
+{
+    uint32_t i;
+
+    for (i = 0; i < DPS150_SCHED_ENTRY_CNT; i++) {
+        if (sched->entries[i].reg == reg) {
+            return &sched->entries[i];
+        }
+    }
+
+    return NULL;
+}
+
+static uint64_t period_of(const dps150_sched_t *sched, uint8_t mul)
+{
+    return sched->base_us * mul;
+}
@@ -0,0 +1,131 @@
+/**
+ * @file dps150_sched.h
+ *
+ * Adaptive per-register polling scheduler
+ *
+ * Each polled register has its own period. Measurements are polled at
+ * their fastest period while their value moves and back off towards a
+ * slower one while it is steady; everything slows down further while
+ * the output is off. Settings and model strings are only refreshed by
+ * the occasional full status block or on demand.
+ *
+ */
+
+#ifndef DPS150_SCHED_H
+#define DPS150_SCHED_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "dps150_proto.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/* Number of scheduled registers */
+#define DPS150_SCHED_ENTRY_CNT 12
+
+#define DPS150_SCHED_NO_DEADLINE UINT64_MAX
+
+/* Bytes of a reply remembered to tell whether the value moved */
+#define DPS150_SCHED_SIG_SIZE 12
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+typedef struct {
+    uint8_t reg;
+    bool once;                  /* Polled until it answers once, then on demand only */
+    bool demand;                /* Due now regardless of the period */
+    uint64_t period_us;         /* Current period, between the fast and slow ones */
+    uint64_t next_us;           /* Next poll, DPS150_SCHED_NO_DEADLINE if not scheduled */
+    uint8_t sig[DPS150_SCHED_SIG_SIZE];
+    uint8_t sig_len;
+    uint32_t polls;             /* Requests issued */
+} dps150_sched_entry_t;
+
+typedef struct {
+    dps150_sched_entry_t entries[DPS150_SCHED_ENTRY_CNT];
+    uint64_t base_us;           /* Fastest period, scales the whole table */
+    bool output_on;
+} dps150_sched_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Initialize the scheduler, every register is due immediately
+ * @param sched the scheduler
+ * @param base_ms period of the fastest register while the output is on and moving
+ * @param now_us the current monotonic time
+ */
+void dps150_sched_init(dps150_sched_t *sched, uint32_t base_ms, uint64_t now_us);
+
+/**
+ * Make every periodic register due now, e.g. after the link came back
+ * @description the adapted periods are kept, the registers read once
+ * are not read again if they answered
+ * @param sched the scheduler
+ * @param now_us the current monotonic time
+ */
+void dps150_sched_restart(dps150_sched_t *sched, uint64_t now_us);
+
+/**
+ * Change the fastest period - the other periods keep their ratio to it
+ * @param sched the scheduler
+ * @param base_ms the new period
+ */
+void dps150_sched_set_base(dps150_sched_t *sched, uint32_t base_ms);
+
+/**
+ * Make a register due now, e.g. after it was written
+ * @param sched the scheduler
+ * @param reg the register type
+ * @return 0 on success, -1 if the register is not scheduled
+ */
+int dps150_sched_demand(dps150_sched_t *sched, uint8_t reg);
+
+/**
+ * Get the next register to poll and schedule its following poll
+ * @param sched the scheduler
+ * @param now_us the current monotonic time
+ * @return the register type, 0 if nothing is due
+ */
+uint8_t dps150_sched_next(dps150_sched_t *sched, uint64_t now_us);
+
+/**
+ * Get the time at which the next register is due
+ * @param sched the scheduler
+ * @return the monotonic time, DPS150_SCHED_NO_DEADLINE if nothing is scheduled
+ */
+uint64_t dps150_sched_next_deadline(const dps150_sched_t *sched);
+
+/**
+ * Adapt the periods to a received reply
+ * @param sched the scheduler
+ * @param type the register type of the reply
+ * @param payload the payload
+ * @param len the payload length
+ */
+void dps150_sched_on_reply(dps150_sched_t *sched, uint8_t type, const uint8_t *payload,
+                           uint8_t len);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*DPS150_SCHED_H*/
@@ -0,0 +1,130 @@
+/**
+ * @file dps150_shadow.c
+ *
+ * In-memory shadow of the DPS150 registers
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include <string.h>
+
+#include "dps150_shadow.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void dps150_shadow_init(dps150_shadow_t *shadow)
+{
+    memset(shadow, 0, sizeof(*shadow));
+}
+
+void dps150_shadow_reset(dps150_shadow_t *shadow)
+{
+    memset(&shadow->status, 0, sizeof(shadow->status));
+    shadow->dirty = 0;
+    shadow->valid = 0;
+}
+
+int dps150_shadow_subscribe(dps150_shadow_t *shadow, uint64_t mask, dps150_shadow_cb_t cb,
+                            void *user_data)
+{
+    dps150_shadow_sub_t *sub;
+
+    if (shadow->sub_cnt == DPS150_SHADOW_SUB_MAX) {
+        return -1;
+    }
+
+    sub = &shadow->subs[shadow->sub_cnt++];
+    sub->mask = mask;
+    sub->cb = cb;
+    sub->user_data = user_data;
+
+    return 0;
+}
+
+uint64_t dps150_shadow_update(dps150_shadow_t *shadow, uint8_t type, const uint8_t *payload,
+                              uint8_t len)
+{
+    dps150_status_t next;
+    const dps150_reg_desc_t *desc;
+    uint64_t decoded;
+    uint64_t changed = 0;
+    uint8_t *dst;
+    const uint8_t *src;
+    uint32_t i;
+
+    /* Decode into a copy, then only take the fields that differ */
+    next = shadow->status;
+    decoded = dps150_regs_decode(&next, type, payload, len);
+
+    for (i = 0; decoded != 0; i++, decoded >>= 1) {
+        if ((decoded & 1) == 0) {
+            continue;
+        }
+
+        desc = &dps150_regs[i];
+        dst = (uint8_t *)&shadow->status + desc->status_offset;
+        src = (const uint8_t *)&next + desc->status_offset;
+
+        if ((shadow->valid & DPS150_FIELD_BIT(i)) && memcmp(dst, src, desc->size) == 0) {
+            continue;
+        }
+
+        memcpy(dst, src, desc->size);
+        shadow->generation[i]++;
+        changed |= DPS150_FIELD_BIT(i);
+    }
+
+    shadow->valid |= changed;
+    shadow->dirty |= changed;
+
+    return changed;
+}
+
+void dps150_shadow_notify(dps150_shadow_t *shadow)
+{
+    const dps150_shadow_sub_t *sub;
+    uint64_t dirty = shadow->dirty;
+    uint32_t i;
+
+    if (dirty == 0) {
+        return;
+    }
+
+    /* Cleared first so a callback may update the shadow again */
+    shadow->dirty = 0;
+
+    for (i = 0; i < shadow->sub_cnt; i++) {
+        sub = &shadow->subs[i];
+        if (sub->mask & dirty) {
+            sub->cb(&shadow->status, sub->mask & dirty, sub->user_data);
+        }
+    }
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
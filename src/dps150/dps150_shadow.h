@@ -0,0 +1,122 @@
+/**
+ * @file dps150_shadow.h
+ *
+ * In-memory shadow of the DPS150 registers
+ *
+ * Replies are merged into the shadow, a field only counts as changed
+ * when its value differs from the shadowed one. Each field has a
+ * generation counter bumped on every change and changed fields are
+ * collected in a dirty mask until the subscribers are notified.
+ *
+ */
+
+#ifndef DPS150_SHADOW_H
+#define DPS150_SHADOW_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include <stdint.h>
+
+#include "dps150_regs.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+#define DPS150_SHADOW_SUB_MAX 16
+
+/* Subscribe to every field */
+#define DPS150_SHADOW_ALL_FIELDS ((UINT64_C(1) << _DPS150_FIELD_CNT) - 1)
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**
+ * Change notification
+ * @param status the shadowed registers
+ * @param changed the subscribed fields which changed since the last notification
+ * @param user_data the pointer given to dps150_shadow_subscribe
+ */
+typedef void (*dps150_shadow_cb_t)(const dps150_status_t *status, uint64_t changed,
+                                   void *user_data);
+
+typedef struct {
+    uint64_t mask;
+    dps150_shadow_cb_t cb;
+    void *user_data;
+} dps150_shadow_sub_t;
+
+typedef struct {
+    dps150_status_t status;
+    uint32_t generation[_DPS150_FIELD_CNT];
+    uint64_t dirty;         /* Changed fields not notified yet */
+    uint64_t valid;         /* Fields received at least once */
+
+    dps150_shadow_sub_t subs[DPS150_SHADOW_SUB_MAX];
+    uint32_t sub_cnt;
+} dps150_shadow_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Initialize an empty shadow without subscribers
+ * @param shadow the shadow
+ */
+void dps150_shadow_init(dps150_shadow_t *shadow);
+
+/**
+ * Forget the shadowed values - keeps the subscribers, the next reply
+ * marks every field it carries as changed
+ * @param shadow the shadow
+ */
+void dps150_shadow_reset(dps150_shadow_t *shadow);
+
+/**
+ * Register a change notification
+ * @param shadow the shadow
+ * @param mask the fields of interest, bit n is dps150_field_t n
+ * @param cb called by dps150_shadow_notify
+ * @param user_data passed to cb
+ * @return 0 on success, -1 if there is no free subscriber slot
+ */
+int dps150_shadow_subscribe(dps150_shadow_t *shadow, uint64_t mask, dps150_shadow_cb_t cb,
+                            void *user_data);
+
+/**
+ * Merge a CMD_GET reply into the shadow
+ *
+ * @param shadow the shadow
+ * @param type the register type of the reply
+ * @param payload the payload
+ * @param len the payload length
+ * @return the mask of the fields whose value changed
+ */
+uint64_t dps150_shadow_update(dps150_shadow_t *shadow, uint8_t type, const uint8_t *payload,
+                              uint8_t len);
+
+/**
+ * Call the subscribers of the dirty fields and clear the dirty mask
+ * @param shadow the shadow
+ */
+void dps150_shadow_notify(dps150_shadow_t *shadow);
+
+/**********************
+ *      MACROS
+ **********************/
+
+/* Number of changes of a field since the shadow was initialized */
+#define dps150_shadow_generation(shadow, field) ((shadow)->generation[field])
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*DPS150_SHADOW_H*/
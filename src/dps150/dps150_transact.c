@@ -0,0 +1,188 @@
+/**
+ * @file dps150_transact.c
+ *
+ * Pipelined request/response engine
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include <string.h>
+
+#include "dps150_transact.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+#define TIMEOUT_US ((uint64_t)DPS150_TRANSACT_TIMEOUT_MS * 1000u)
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void dps150_transact_init(dps150_transact_t *t, dps150_transact_send_cb_t send_cb, void *user_data)
+{
+    memset(t, 0, sizeof(*t));
+    t->send_cb = send_cb;
+    t->user_data = user_data;
+    t->rtt_min_us = UINT32_MAX;
+}
+
+void dps150_transact_reset(dps150_transact_t *t)
+{
+    memset(t->txn, 0, sizeof(t->txn));
+    t->inflight = 0;
+}
+
+bool dps150_transact_can_send(const dps150_transact_t *t)
+{
+    return t->inflight < DPS150_TRANSACT_WINDOW;
+}
+
+int dps150_transact_request(dps150_transact_t *t, uint8_t type, uint64_t now_us)
+{
+    dps150_txn_t *txn = NULL;
+    int i;
+
+    for (i = 0; i < DPS150_TRANSACT_WINDOW; i++) {
+        if (!t->txn[i].in_use) {
+            txn = &t->txn[i];
+            break;
+        }
+    }
+
+    if (txn == NULL || t->send_cb(type, t->user_data) != 0) {
+        return -1;
+    }
+
+    txn->type = type;
+    txn->sent_us = now_us;
+    txn->first_us = 0;
+    txn->seq = t->next_seq++;
+    txn->retries_left = DPS150_TRANSACT_RETRIES;
+    txn->in_use = true;
+    txn->writing = true;
+    t->inflight++;
+
+    return 0;
+}
+
+void dps150_transact_written(dps150_transact_t *t, uint8_t type, uint64_t now_us)
+{
+    dps150_txn_t *oldest = NULL;
+    int i;
+
+    for (i = 0; i < DPS150_TRANSACT_WINDOW; i++) {
+        dps150_txn_t *txn = &t->txn[i];
+
+        if (txn->in_use && txn->writing && txn->type == type &&
+            (oldest == NULL || txn->seq < oldest->seq)) {
+            oldest = txn;
+        }
+    }
+
+    if (oldest == NULL) {
+        return;
+    }
+
+    oldest->writing = false;
+    oldest->sent_us = now_us;
+    if (oldest->first_us == 0) {
+        oldest->first_us = now_us;
+    }
+}
+
+int32_t dps150_transact_complete(dps150_transact_t *t, uint8_t type, uint64_t now_us)
+{
+    dps150_txn_t *oldest = NULL;
+    uint32_t rtt;
+    int i;
+
+    for (i = 0; i < DPS150_TRANSACT_WINDOW; i++) {
+        dps150_txn_t *txn = &t->txn[i];
+
+        if (txn->in_use && txn->type == type && (oldest == NULL || txn->seq < oldest->seq)) {
+            oldest = txn;
+        }
+    }
+
+    if (oldest == NULL) {
+        t->unsolicited++;
+        return -1;
+    }
+
+    /* A late reply to the first transmission of a retried request is not
+     * timed from the retry */
+    rtt = (uint32_t)(now_us - (oldest->first_us != 0 ? oldest->first_us : oldest->sent_us));
+    oldest->in_use = false;
+    t->inflight--;
+
+    t->completed++;
+    t->rtt_sum_us += rtt;
+    if (rtt < t->rtt_min_us) t->rtt_min_us = rtt;
+    if (rtt > t->rtt_max_us) t->rtt_max_us = rtt;
+
+    return (int32_t)rtt;
+}
+
+void dps150_transact_tick(dps150_transact_t *t, uint64_t now_us)
+{
+    int i;
+
+    for (i = 0; i < DPS150_TRANSACT_WINDOW; i++) {
+        dps150_txn_t *txn = &t->txn[i];
+
+        /* A request waiting to be written has no deadline yet, it would be
+         * handed to send_cb twice */
+        if (!txn->in_use || txn->writing || now_us < txn->sent_us + TIMEOUT_US) {
+            continue;
+        }
+
+        if (txn->retries_left > 0 && t->send_cb(txn->type, t->user_data) == 0) {
+            txn->retries_left--;
+            txn->sent_us = now_us;
+            txn->writing = true;
+            t->retries++;
+        } else {
+            txn->in_use = false;
+            t->inflight--;
+            t->failed++;
+        }
+    }
+}
+
+uint64_t dps150_transact_next_deadline(const dps150_transact_t *t)
+{
+    uint64_t deadline = DPS150_TRANSACT_NO_DEADLINE;
+    int i;
+
+    for (i = 0; i < DPS150_TRANSACT_WINDOW; i++) {
+        if (t->txn[i].in_use && !t->txn[i].writing && t->txn[i].sent_us + TIMEOUT_US < deadline) {
+            deadline = t->txn[i].sent_us + TIMEOUT_US;
+        }
+    }
+
+    return deadline;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
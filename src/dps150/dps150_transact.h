@@ -0,0 +1,165 @@
+/**
+ * @file dps150_transact.h
+ *
+ * Pipelined request/response engine
+ *
+ * Keeps several CMD_GET requests in flight at the same time. Replies
+ * carry the register type they answer, they are matched to the oldest
+ * outstanding request of that type - the link delivers them in order.
+ * Each request has its own deadline, started when it is written to the
+ * link. A request which times out is sent again until it runs out of
+ * retries. The round-trip latency of every completed request is
+ * measured from the time its first transmission was written to the
+ * link, reported with dps150_transact_written.
+ *
+ * Not thread safe, meant to be driven by the serial I/O thread.
+ *
+ */
+
+#ifndef DPS150_TRANSACT_H
+#define DPS150_TRANSACT_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include <stdint.h>
+#include <stdbool.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/* Maximum number of requests in flight */
+#define DPS150_TRANSACT_WINDOW 4
+
+/* Time to wait for a reply before sending the request again */
+#define DPS150_TRANSACT_TIMEOUT_MS 250
+
+/* Number of times a request is sent again before it is given up */
+#define DPS150_TRANSACT_RETRIES 2
+
+/* Returned by dps150_transact_next_deadline when nothing is in flight */
+#define DPS150_TRANSACT_NO_DEADLINE UINT64_MAX
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/* Sends the CMD_GET request of a register type, returns 0 on success */
+typedef int (*dps150_transact_send_cb_t)(uint8_t type, void *user_data);
+
+typedef struct {
+    uint64_t sent_us;           /* Time of the last transmission, the deadline starts there */
+    uint64_t first_us;          /* First transmission written to the link, 0 before */
+    uint64_t seq;               /* Issue order, used to find the oldest request */
+    uint8_t type;
+    uint8_t retries_left;
+    bool in_use;
+    bool writing;               /* Handed to send_cb, not written yet */
+} dps150_txn_t;
+
+typedef struct {
+    dps150_txn_t txn[DPS150_TRANSACT_WINDOW];
+    uint32_t inflight;
+    uint64_t next_seq;
+
+    dps150_transact_send_cb_t send_cb;
+    void *user_data;
+
+    /* Statistics */
+    uint32_t completed;         /* Requests answered */
+    uint32_t retries;           /* Requests sent again after a timeout */
+    uint32_t failed;            /* Requests given up after the last retry */
+    uint32_t unsolicited;       /* Replies that did not match a request */
+    uint32_t rtt_min_us;
+    uint32_t rtt_max_us;
+    uint64_t rtt_sum_us;
+} dps150_transact_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Initialize the engine
+ *
+ * @param t the engine
+ * @param send_cb writes a request to the link
+ * @param user_data passed to send_cb
+ */
+void dps150_transact_init(dps150_transact_t *t, dps150_transact_send_cb_t send_cb, void *user_data);
+
+/**
+ * Forget every request in flight, the statistics are kept
+ * @param t the engine
+ */
+void dps150_transact_reset(dps150_transact_t *t);
+
+/**
+ * Check if another request can be issued
+ * @param t the engine
+ * @return true if the window is not full
+ */
+bool dps150_transact_can_send(const dps150_transact_t *t);
+
+/**
+ * Issue a request
+ *
+ * @param t the engine
+ * @param type the register type to read
+ * @param now_us current monotonic time
+ * @return 0 on success, -1 if the window is full or sending failed
+ */
+int dps150_transact_request(dps150_transact_t *t, uint8_t type, uint64_t now_us);
+
+/**
+ * Tell that a request handed to send_cb is now on the wire
+ *
+ * @description the oldest request of the type waiting to be written is
+ * taken, its deadline starts now
+ * @param t the engine
+ * @param type the register type of the written request
+ * @param now_us time of the write
+ */
+void dps150_transact_written(dps150_transact_t *t, uint8_t type, uint64_t now_us);
+
+/**
+ * Match a reply to the oldest outstanding request of its type
+ *
+ * @param t the engine
+ * @param type the register type of the reply
+ * @param now_us time of reception
+ * @return the round-trip latency in microseconds since the first transmission,
+ * -1 for an unsolicited reply
+ */
+int32_t dps150_transact_complete(dps150_transact_t *t, uint8_t type, uint64_t now_us);
+
+/**
+ * Handle expired requests - send them again or give them up
+ *
+ * @param t the engine
+ * @param now_us current monotonic time
+ */
+void dps150_transact_tick(dps150_transact_t *t, uint64_t now_us);
+
+/**
+ * Get the earliest request deadline
+ *
+ * @param t the engine
+ * @return monotonic time in microseconds or DPS150_TRANSACT_NO_DEADLINE
+ */
+uint64_t dps150_transact_next_deadline(const dps150_transact_t *t);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*DPS150_TRANSACT_H*/
@@ -0,0 +1,526 @@
+/**
+ * @file port_watch.c
+ *
+ * Serial port hot-plug watcher
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include <unistd.h>
+#include <pthread.h>
+#include <poll.h>
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <dirent.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+
+#include "port_watch.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+#ifndef PORT_WATCH_DEV_DIR
+#define PORT_WATCH_DEV_DIR "/dev"
+#endif
+
+#ifndef PORT_WATCH_SYSFS_TTY_DIR
+#define PORT_WATCH_SYSFS_TTY_DIR "/sys/class/tty"
+#endif
+
+/* USB interface class of CDC ACM ports */
+#define USB_CLASS_COMM 0x02
+
+/* Levels walked up from the tty device to the USB device */
+#define SYSFS_DEPTH_MAX 4
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+typedef struct {
+    uint16_t vid;
+    uint16_t pid;
+} usb_id_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void *watch_thread(void *arg);
+static void scan_dev(void);
+static void handle_inotify(int fd);
+static bool is_candidate_name(const char *name);
+static bool probe_port(const char *name, port_watch_port_t *port);
+static int read_attr(const char *dir, const char *attr, char *buf, size_t size);
+static void add_port(const char *name);
+static void remove_port(const char *name);
+static int port_cmp(const port_watch_port_t *a, const port_watch_port_t *b);
+static void signal_change(void);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/* Prefixes of the USB serial nodes, ttyS* are never USB devices */
+static const char *const name_prefixes[] = { "ttyACM", "ttyUSB" };
+
+/* The DPS-150 enumerates as the Artery AT32 virtual COM port */
+static const usb_id_t dps150_ids[] = {
+    { 0x2e3c, 0x5740 },
+};
+
+static pthread_t thread;
+static bool thread_running = false;
+static int wake_fd = -1;
+static int event_fd = -1;
+
+/* Owned by the watcher thread, copied under the lock */
+static pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER;
+static port_watch_port_t ports[PORT_WATCH_MAX];
+static uint32_t port_cnt;
+static uint32_t generation;
+
+/**********************
+ *      MACROS
+ **********************/
+
+#define ARRAY_LEN(a) (sizeof(a) / sizeof((a)[0]))
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+int port_watch_start(void)
+{
+    if (thread_running) {
+        return 0;
+    }
+
+    wake_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    event_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (wake_fd < 0 || event_fd < 0) {
+        perror("port_watch eventfd");
+        goto fail;
+    }
+
+    port_cnt = 0;
+
+    if (pthread_create(&thread, NULL, watch_thread, NULL) != 0) {
+        goto fail;
+    }
+
+    thread_running = true;
+    return 0;
+
+fail:
+    if (wake_fd >= 0) {
+        close(wake_fd);
+        wake_fd = -1;
+    }
+    if (event_fd >= 0) {
+        close(event_fd);
+        event_fd = -1;
+    }
+    return -1;
+}
+
+void port_watch_stop(void)
+{
+    uint64_t one = 1;
+
+    if (!thread_running) {
+        return;
+    }
+
+    if (write(wake_fd, &one, sizeof(one)) < 0) {
+        perror("port_watch_stop");
+    }
+
+    pthread_join(thread, NULL);
+    thread_running = false;
+
+    close(wake_fd);
+    close(event_fd);
+    wake_fd = -1;
+    event_fd = -1;
+}
+
+int port_watch_get_event_fd(void)
+{
+    return event_fd;
+}
+
+int port_watch_get_ports(port_watch_port_t *out, uint32_t *gen)
+{
+    int cnt;
+
+    pthread_mutex_lock(&lock);
+
+    if (gen != NULL && *gen == generation) {
+        pthread_mutex_unlock(&lock);
+        return -1;
+    }
+
+    memcpy(out, ports, port_cnt * sizeof(ports[0]));
+    cnt = (int)port_cnt;
+    if (gen != NULL) {
+        *gen = generation;
+    }
+
+    pthread_mutex_unlock(&lock);
+
+    return cnt;
+}
+
+int port_watch_find(const char *serial, char *path, size_t size)
+{
+    port_watch_port_t port;
+    struct dirent *ent;
+    DIR *dir;
+    int ret = -1;
+
+    if (serial[0] == '\0' || (dir = opendir(PORT_WATCH_SYSFS_TTY_DIR)) == NULL) {
+        return -1;
+    }
+
+    while (ret != 0 && (ent = readdir(dir)) != NULL) {
+        if (!is_candidate_name(ent->d_name)) {
+            continue;
+        }
+
+        /* The identity is filled even for ports that are not listed */
+        probe_port(ent->d_name, &port);
+        if (strcmp(port.serial, serial) == 0) {
+            snprintf(path, size, PORT_WATCH_DEV_DIR "/%s", ent->d_name);
+            ret = 0;
+        }
+    }
+
+    closedir(dir);
+    return ret;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * The watcher thread
+ *
+ * @description scans the device directory once, then applies the
+ * inotify events until port_watch_stop signals the wake event
+ */
+static void *watch_thread(void *arg)
+{
+    struct pollfd fds[2];
+    int ifd;
+
+    (void)arg;
+
+    ifd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (ifd < 0 || inotify_add_watch(ifd, PORT_WATCH_DEV_DIR,
+                                     IN_CREATE | IN_DELETE | IN_ATTRIB | IN_MOVED_TO |
+                                     IN_MOVED_FROM) < 0) {
+        perror("port_watch inotify");
+    }
+
+    /* Watch first, then scan: a port plugged in between is not missed */
+    scan_dev();
+    signal_change();
+
+    fds[0].fd = ifd;
+    fds[0].events = POLLIN;
+    fds[1].fd = wake_fd;
+    fds[1].events = POLLIN;
+
+    while (poll(fds, 2, -1) >= 0 || errno == EINTR) {
+        if (fds[1].revents & POLLIN) {
+            break;
+        }
+        if (fds[0].revents & POLLIN) {
+            handle_inotify(ifd);
+        }
+    }
+
+    if (ifd >= 0) {
+        close(ifd);
+    }
+
+    return NULL;
+}
+
+/**
+ * Add the candidate ports already present in the device directory
+ */
+static void scan_dev(void)
+{
+    struct dirent *ent;
+    DIR *dir = opendir(PORT_WATCH_DEV_DIR);
+
+    if (dir == NULL) {
+        perror(PORT_WATCH_DEV_DIR);
+        return;
+    }
+
+    while ((ent = readdir(dir)) != NULL) {
+        if (is_candidate_name(ent->d_name)) {
+            add_port(ent->d_name);
+        }
+    }
+
+    closedir(dir);
+}
+
+/**
+ * Apply the pending inotify events to the port list
+ *
+ * @param fd the inotify instance
+ */
+static void handle_inotify(int fd)
+{
+    char buf[4096] __attribute__((aligned(__alignof__(struct inotify_event))));
+    const struct inotify_event *ev;
+    uint32_t gen;
+    ssize_t len;
+    char *p;
+
+    pthread_mutex_lock(&lock);
+    gen = generation;
+    pthread_mutex_unlock(&lock);
+
+    while ((len = read(fd, buf, sizeof(buf))) > 0) {
+        for (p = buf; p < buf + len; p += sizeof(*ev) + ev->len) {
+            ev = (const struct inotify_event *)p;
+
+            if (ev->len == 0 || !is_candidate_name(ev->name)) {
+                continue;
+            }
+
+            if (ev->mask & (IN_DELETE | IN_MOVED_FROM)) {
+                remove_port(ev->name);
+            } else {
+                /* IN_ATTRIB retries a port whose sysfs entry was not ready */
+                add_port(ev->name);
+            }
+        }
+    }
+
+    pthread_mutex_lock(&lock);
+    if (generation != gen) {
+        pthread_mutex_unlock(&lock);
+        signal_change();
+    } else {
+        pthread_mutex_unlock(&lock);
+    }
+}
+
+/**
+ * Tell whether a device node may be a USB serial port
+ *
+ * @param name the name of the node
+ * @return true if it starts with one of the known prefixes
+ */
+static bool is_candidate_name(const char *name)
+{
+    size_t i;
+
+    for (i = 0; i < ARRAY_LEN(name_prefixes); i++) {
+        if (strncmp(name, name_prefixes[i], strlen(name_prefixes[i])) == 0) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * Read the USB identity of a tty from sysfs
+ *
+ * @param name the tty name
+ * @param port filled with the identity
+ * @return true if it is a CDC ACM interface or a known DPS-150 ID
+ */
+static bool probe_port(const char *name, port_watch_port_t *port)
+{
+    char link[PATH_MAX];
+    char dir[PATH_MAX];
+    char value[16];
+    char *slash;
+    long iface_class = -1;
+    int depth;
+    size_t i;
+
+    memset(port, 0, sizeof(*port));
+    snprintf(port->name, sizeof(port->name), "%s", name);
+
+    snprintf(link, sizeof(link), PORT_WATCH_SYSFS_TTY_DIR "/%s/device", name);
+    if (realpath(link, dir) == NULL) {
+        return false;
+    }
+
+    /* From the interface (or the usb-serial port) up to the USB device */
+    for (depth = 0; depth < SYSFS_DEPTH_MAX; depth++) {
+        if (iface_class < 0 && read_attr(dir, "bInterfaceClass", value, sizeof(value)) == 0) {
+            iface_class = strtol(value, NULL, 16);
+        }
+
+        if (read_attr(dir, "idVendor", value, sizeof(value)) == 0) {
+            port->vid = (uint16_t)strtoul(value, NULL, 16);
+            if (read_attr(dir, "idProduct", value, sizeof(value)) == 0) {
+                port->pid = (uint16_t)strtoul(value, NULL, 16);
+            }
+            read_attr(dir, "serial", port->serial, sizeof(port->serial));
+            break;
+        }
+
+        slash = strrchr(dir, '/');
+        if (slash == NULL || slash == dir) {
+            return false;
+        }
+        *slash = '\0';
+    }
+
+    if (depth == SYSFS_DEPTH_MAX) {
+        return false;
+    }
+
+    for (i = 0; i < ARRAY_LEN(dps150_ids); i++) {
+        if (port->vid == dps150_ids[i].vid && port->pid == dps150_ids[i].pid) {
+            port->dps150 = true;
+        }
+    }
+
+    return port->dps150 || iface_class == USB_CLASS_COMM;
+}
+
+/**
+ * Read a sysfs attribute without its trailing newline
+ *
+ * @param dir the sysfs directory
+ * @param attr the attribute name
+ * @param buf receives the value
+ * @param size the size of buf
+ * @return 0 on success, -1 if it cannot be read
+ */
+static int read_attr(const char *dir, const char *attr, char *buf, size_t size)
+{
+    char path[PATH_MAX];
+    FILE *f;
+    size_t len;
+
+    snprintf(path, sizeof(path), "%s/%s", dir, attr);
+
+    f = fopen(path, "r");
+    if (f == NULL) {
+        return -1;
+    }
+
+    len = fread(buf, 1, size - 1, f);
+    fclose(f);
+
+    while (len > 0 && (buf[len - 1] == '\n' || buf[len - 1] == ' ')) {
+        len--;
+    }
+    buf[len] = '\0';
+
+    return len > 0 ? 0 : -1;
+}
+
+/**
+ * Probe a port and insert it in order, if it is not listed yet
+ *
+ * @param name the tty name
+ */
+static void add_port(const char *name)
+{
+    port_watch_port_t port;
+    uint32_t i;
+
+    pthread_mutex_lock(&lock);
+    for (i = 0; i < port_cnt; i++) {
+        if (strcmp(ports[i].name, name) == 0) {
+            pthread_mutex_unlock(&lock);
+            return;
+        }
+    }
+    pthread_mutex_unlock(&lock);
+
+    /* sysfs is read without the lock, only this thread changes the list */
+    if (!probe_port(name, &port)) {
+        return;
+    }
+
+    pthread_mutex_lock(&lock);
+    if (port_cnt < PORT_WATCH_MAX) {
+        for (i = port_cnt; i > 0 && port_cmp(&port, &ports[i - 1]) < 0; i--) {
+            ports[i] = ports[i - 1];
+        }
+        ports[i] = port;
+        port_cnt++;
+        generation++;
+    }
+    pthread_mutex_unlock(&lock);
+}
+
+/**
+ * Remove a port from the list
+ *
+ * @param name the tty name
+ */
+static void remove_port(const char *name)
+{
+    uint32_t i;
+
+    pthread_mutex_lock(&lock);
+    for (i = 0; i < port_cnt; i++) {
+        if (strcmp(ports[i].name, name) == 0) {
+            memmove(&ports[i], &ports[i + 1], (port_cnt - i - 1) * sizeof(ports[0]));
+            port_cnt--;
+            generation++;
+            break;
+        }
+    }
+    pthread_mutex_unlock(&lock);
+}
+
+/**
+ * Order of the list: DPS-150 matches first, then by name
+ *
+ * @return <0, 0 or >0 like strcmp
+ */
+static int port_cmp(const port_watch_port_t *a, const port_watch_port_t *b)
+{
+    size_t la;
+    size_t lb;
+
+    if (a->dps150 != b->dps150) {
+        return a->dps150 ? -1 : 1;
+    }
+
+    /* ttyACM2 before ttyACM10 */
+    la = strlen(a->name);
+    lb = strlen(b->name);
+    if (la != lb && strncmp(a->name, b->name, 6) == 0) {
+        return la < lb ? -1 : 1;
+    }
+
+    return strcmp(a->name, b->name);
+}
+
+/**
+ * Wake the LVGL thread after the list changed
+ */
+static void signal_change(void)
+{
+    uint64_t one = 1;
+
+    if (write(event_fd, &one, sizeof(one)) < 0 && errno != EAGAIN) {
+        perror("port_watch signal");
+    }
+}
@@ -0,0 +1,100 @@
+/**
+ * @file port_watch.h
+ *
+ * Serial port hot-plug watcher
+ *
+ * A thread watches /dev with inotify and keeps a list of the USB
+ * serial ports that may be a DPS-150: CDC ACM interfaces and known
+ * vendor/product IDs. The USB identity of each port is read from
+ * sysfs. The LVGL thread is signaled through an eventfd and copies
+ * the list when it changed.
+ *
+ */
+
+#ifndef PORT_WATCH_H
+#define PORT_WATCH_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/* Ports listed at most, further ones are ignored */
+#define PORT_WATCH_MAX 16
+
+#define PORT_WATCH_NAME_MAX 32
+#define PORT_WATCH_SERIAL_MAX 64
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+typedef struct {
+    char name[PORT_WATCH_NAME_MAX];         /* Node in /dev, e.g ttyACM0 */
+    char serial[PORT_WATCH_SERIAL_MAX];     /* USB serial number, empty if none */
+    uint16_t vid;
+    uint16_t pid;
+    bool dps150;                            /* Vendor/product ID of a DPS-150 */
+} port_watch_port_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Start the watcher thread, it scans /dev first
+ * @return 0 on success, -1 on error
+ */
+int port_watch_start(void);
+
+/**
+ * Stop the watcher thread and wait for it to exit
+ */
+void port_watch_stop(void);
+
+/**
+ * Get a file descriptor that becomes readable when the list changed
+ * @description read its counter before calling port_watch_get_ports
+ * @return the eventfd, -1 if the watcher is not running
+ */
+int port_watch_get_event_fd(void);
+
+/**
+ * Copy the current list, DPS-150 matches first then sorted by name
+ * @param ports filled with up to PORT_WATCH_MAX ports
+ * @param generation in: the generation of the caller's copy, out: the
+ * current one. May be NULL
+ * @return the number of ports, -1 if the list did not change since
+ * the given generation
+ */
+int port_watch_get_ports(port_watch_port_t *ports, uint32_t *generation);
+
+/**
+ * Look a port up by its USB serial number, without the watcher thread
+ * @description reads sysfs directly, may be called from any thread
+ * @param serial the USB serial number
+ * @param path receives the device path
+ * @param size the size of path
+ * @return 0 if found, -1 otherwise
+ */
+int port_watch_find(const char *serial, char *path, size_t size);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*PORT_WATCH_H*/
@@ -0,0 +1,1010 @@
+/**
+ * @file serial_io.c
+ *
+ * Dedicated serial I/O thread
+ *
+ * The thread is the only writer of the UART. Frames queued by the LVGL
+ * thread and the status requests of the thread itself are gathered into
+ * a single writev(2) call. A partial write is resumed once the port
+ * signals POLLOUT, the received data is never flushed.
+ *
+ * Registers are polled by the adaptive scheduler, a register written by
+ * a queued CMD_SET is read back as soon as the frame is on the wire.
+ *
+ * A port that fails is closed and reopened with an exponential backoff,
+ * found again by its USB serial number. The backoff starts over only
+ * after the device answered on the new link. Requests in flight are dropped
+ * and every polled register is due again once the link is back.
+ *
+ * The traffic can be recorded to a capture file. In replay mode the
+ * thread reads such a file instead of the UART and feeds the received
+ * bytes to the parser, in real time, accelerated or as fast as the
+ * consumer keeps up.
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include <unistd.h>
+#include <pthread.h>
+#include <poll.h>
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdbool.h>
+#include <sys/eventfd.h>
+#include <sys/uio.h>
+
+#include "../lib/simulator_util.h"
+#include "spsc_ring.h"
+#include "dps150_parser.h"
+#include "dps150_transact.h"
+#include "dps150_encode.h"
+#include "dps150_sched.h"
+#include "capture.h"
+#include "port_watch.h"
+#include "dps150_probe.h"
+#include "serial_io.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/* Bytes read from the UART at once, frames may span several reads */
+#define RX_CHUNK_SIZE 512
+
+/* Size of a CMD_GET request */
+#define GET_FRAME_LEN DPS150_FRAME_U8_LEN
+
+/* Requests of the thread itself waiting to be written */
+#define GET_STAGE_SIZE (DPS150_TRANSACT_WINDOW * 2)
+
+/* Maximum number of frames written by one writev(2) call */
+#define TX_BATCH_MAX (GET_STAGE_SIZE + SERIAL_IO_TX_QUEUE_SIZE)
+
+/* Longest time the recorded traffic stays in the stdio buffer of the capture */
+#define CAPTURE_FLUSH_MS 1000
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/* One entry of the transmit frame pool */
+typedef struct {
+    uint64_t enqueue_us;
+    uint16_t len;
+    uint8_t data[DPS150_FRAME_MAX];
+} tx_slot_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static int start_thread(int fd, void *(*fn)(void *));
+static void *io_thread(void *arg);
+static void *replay_thread(void *arg);
+static void frame_cb(uint8_t cmd, uint8_t type, const uint8_t *payload, uint8_t len,
+                     void *user_data);
+static int send_get(uint8_t type, void *user_data);
+static int flush_tx(void);
+static bool tx_pending(void);
+static void publish_error(int err);
+static void publish_status(uint8_t type, int err);
+static void capture_tx(const struct iovec *iov, int cnt, size_t written, uint64_t now);
+static void signal_event(void);
+static bool link_failed(int err);
+static int reconnect(void);
+static void backoff(uint64_t now);
+static void flush_capture(uint64_t now);
+static void start_session(uint64_t now);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+static serial_io_evt_t ring_storage[SERIAL_IO_RING_SIZE];
+static spsc_ring_t ring;
+
+static tx_slot_t tx_pool[SERIAL_IO_TX_QUEUE_SIZE];
+static spsc_ring_t tx_ring;
+
+static pthread_t thread;
+static bool thread_running = false;
+static bool stop_requested;
+static int uart = -1;
+static int wake_fd = -1;
+static int event_fd = -1;       /* Signaled on publish, lives as long as the process */
+static uint32_t poll_period_ms = SERIAL_IO_POLL_PERIOD_MS;
+static serial_io_tx_stats_t tx_stats;
+
+/* Owned by the I/O thread */
+static uint8_t rx_chunk[RX_CHUNK_SIZE];
+static dps150_parser_t parser;
+static dps150_transact_t transact;
+static dps150_sched_t sched;
+static uint32_t sched_base_ms;
+static uint32_t dropped;
+
+static uint8_t get_stage[GET_STAGE_SIZE][GET_FRAME_LEN];
+static uint32_t get_cnt;
+static uint32_t get_offset;     /* Bytes of get_stage[0] already written */
+static uint32_t tx_offset;      /* Bytes of the oldest tx_pool entry already written */
+
+static const char *capture_path;
+static capture_t capture;
+static uint8_t capture_buf[TX_BATCH_MAX * DPS150_FRAME_MAX];
+static uint64_t capture_flush_at;
+
+static float replay_speed;
+static bool replaying;
+
+/* Reconnection, the state is owned by the I/O thread */
+static bool reconnect_enabled;
+static char reconnect_path[SERIAL_IO_PATH_MAX];
+static char reconnect_serial[PORT_WATCH_SERIAL_MAX];
+static uint32_t reconnect_delay_ms;    /* 0 until the first failure */
+static bool link_healthy;               /* A reply arrived since the link came up */
+static uint64_t reconnect_at;
+static uint32_t reconnects;
+
+/**********************
+ *      MACROS
+ **********************/
+
+#define STAT_ADD(field, val) __atomic_fetch_add(&tx_stats.field, (val), __ATOMIC_RELAXED)
+#define STAT_MAX(field, val) \
+    do { \
+        if ((val) > __atomic_load_n(&tx_stats.field, __ATOMIC_RELAXED)) { \
+            __atomic_store_n(&tx_stats.field, (val), __ATOMIC_RELAXED); \
+        } \
+    } while (0)
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+int serial_io_start(int fd)
+{
+    if (thread_running) {
+        return -1;
+    }
+
+    /* The capture is created on the first connection and spans the next ones */
+    if (capture_path != NULL && capture.file == NULL) {
+        if (capture_create(&capture, capture_path) != 0) {
+            perror("serial_io capture");
+            capture_path = NULL;
+        }
+    }
+
+    replaying = false;
+    return start_thread(fd, io_thread);
+}
+
+int serial_io_start_replay(const char *path, float speed)
+{
+    if (thread_running) {
+        return -1;
+    }
+
+    if (capture_open(&capture, path) != 0) {
+        perror(path);
+        return -1;
+    }
+
+    replay_speed = speed;
+    replaying = true;
+    if (start_thread(-1, replay_thread) != 0) {
+        capture_close(&capture);
+        replaying = false;
+        return -1;
+    }
+
+    return 0;
+}
+
+void serial_io_set_capture(const char *path)
+{
+    capture_path = path;
+}
+
+void serial_io_close_capture(void)
+{
+    /* A replay capture is closed by serial_io_stop */
+    if (thread_running || replaying || capture.file == NULL) {
+        return;
+    }
+
+    capture_close(&capture);
+
+    /* A later connection must not truncate the file */
+    capture_path = NULL;
+}
+
+void serial_io_set_reconnect(const char *path, const char *usb_serial)
+{
+    reconnect_enabled = path != NULL;
+    snprintf(reconnect_path, sizeof(reconnect_path), "%s", path != NULL ? path : "");
+    snprintf(reconnect_serial, sizeof(reconnect_serial), "%s",
+             usb_serial != NULL ? usb_serial : "");
+}
+
+int serial_io_get_fd(void)
+{
+    return uart;
+}
+
+void serial_io_stop(void)
+{
+    uint64_t one = 1;
+
+    if (!thread_running) {
+        return;
+    }
+
+    __atomic_store_n(&stop_requested, true, __ATOMIC_RELEASE);
+    if (write(wake_fd, &one, sizeof(one)) < 0) {
+        perror("serial_io_stop");
+    }
+
+    pthread_join(thread, NULL);
+    thread_running = false;
+
+    close(wake_fd);
+    wake_fd = -1;
+
+    /* Drop anything the other side did not consume */
+    spsc_ring_reset(&ring);
+    spsc_ring_reset(&tx_ring);
+
+    if (replaying) {
+        capture_close(&capture);
+        replaying = false;
+    } else if (capture.file != NULL) {
+        fflush(capture.file);
+    }
+}
+
+serial_io_evt_t *serial_io_peek(void)
+{
+    if (!thread_running) {
+        return NULL;
+    }
+
+    return spsc_ring_peek(&ring);
+}
+
+void serial_io_release(void)
+{
+    spsc_ring_release(&ring);
+}
+
+int serial_io_get_event_fd(void)
+{
+    if (event_fd < 0) {
+        event_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (event_fd < 0) {
+            perror("serial_io eventfd");
+        }
+    }
+
+    return event_fd;
+}
+
+void serial_io_set_poll_period(uint32_t period_ms)
+{
+    /* The scheduler scales every period by it */
+    if (period_ms == 0) {
+        return;
+    }
+    if (period_ms > SERIAL_IO_POLL_PERIOD_MAX_MS) {
+        period_ms = SERIAL_IO_POLL_PERIOD_MAX_MS;
+    }
+
+    __atomic_store_n(&poll_period_ms, period_ms, __ATOMIC_RELAXED);
+}
+
+uint8_t *serial_io_tx_reserve(void)
+{
+    tx_slot_t *slot;
+
+    /* Nothing is written while replaying a capture */
+    if (!thread_running || replaying) {
+        return NULL;
+    }
+
+    slot = spsc_ring_reserve(&tx_ring);
+    if (slot == NULL) {
+        STAT_ADD(rejected, 1);
+        return NULL;
+    }
+
+    return slot->data;
+}
+
+void serial_io_tx_commit(size_t len)
+{
+    tx_slot_t *slot = spsc_ring_reserve(&tx_ring);
+    uint64_t one = 1;
+    uint32_t depth;
+
+    /* Nothing was encoded, the slot stays free */
+    if (slot == NULL || len == 0) {
+        return;
+    }
+
+    slot->enqueue_us = get_monotonic_us();
+    slot->len = (uint16_t)len;
+    spsc_ring_publish(&tx_ring);
+
+    depth = spsc_ring_count(&tx_ring);
+    STAT_MAX(depth_max, depth);
+
+    /* Wake the I/O thread, it does the actual write */
+    if (write(wake_fd, &one, sizeof(one)) < 0 && errno != EAGAIN) {
+        perror("serial_io_tx_commit");
+    }
+}
+
+int serial_io_send(const uint8_t *data, size_t len)
+{
+    uint8_t *buf;
+
+    if (len > DPS150_FRAME_MAX || (buf = serial_io_tx_reserve()) == NULL) {
+        return -1;
+    }
+
+    memcpy(buf, data, len);
+    serial_io_tx_commit(len);
+
+    return 0;
+}
+
+void serial_io_get_tx_stats(serial_io_tx_stats_t *stats)
+{
+    stats->frames = __atomic_load_n(&tx_stats.frames, __ATOMIC_RELAXED);
+    stats->batches = __atomic_load_n(&tx_stats.batches, __ATOMIC_RELAXED);
+    stats->bytes = __atomic_load_n(&tx_stats.bytes, __ATOMIC_RELAXED);
+    stats->rejected = __atomic_load_n(&tx_stats.rejected, __ATOMIC_RELAXED);
+    stats->depth = thread_running ? spsc_ring_count(&tx_ring) : 0;
+    stats->depth_max = __atomic_load_n(&tx_stats.depth_max, __ATOMIC_RELAXED);
+    stats->latency_sum_us = __atomic_load_n(&tx_stats.latency_sum_us, __ATOMIC_RELAXED);
+    stats->latency_max_us = __atomic_load_n(&tx_stats.latency_max_us, __ATOMIC_RELAXED);
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Reset the shared state and start a thread
+ *
+ * @param fd the UART, -1 for a replay
+ * @param fn the thread function
+ * @return 0 on success, -1 on error
+ */
+static int start_thread(int fd, void *(*fn)(void *))
+{
+    spsc_ring_init(&ring, ring_storage, sizeof(ring_storage[0]), SERIAL_IO_RING_SIZE);
+    spsc_ring_init(&tx_ring, tx_pool, sizeof(tx_pool[0]), SERIAL_IO_TX_QUEUE_SIZE);
+
+    wake_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (wake_fd < 0) {
+        perror("eventfd");
+        return -1;
+    }
+
+    uart = fd;
+    stop_requested = false;
+    dps150_parser_init(&parser, HEADER_INPUT, frame_cb, NULL);
+    dps150_transact_init(&transact, send_get, NULL);
+    sched_base_ms = __atomic_load_n(&poll_period_ms, __ATOMIC_RELAXED);
+    dps150_sched_init(&sched, sched_base_ms, get_monotonic_us());
+    dropped = 0;
+    get_cnt = 0;
+    get_offset = 0;
+    tx_offset = 0;
+    reconnect_delay_ms = 0;
+    link_healthy = false;
+    capture_flush_at = 0;
+    memset(&tx_stats, 0, sizeof(tx_stats));
+
+    if (pthread_create(&thread, NULL, fn, NULL) != 0) {
+        close(wake_fd);
+        wake_fd = -1;
+        return -1;
+    }
+
+    thread_running = true;
+    return 0;
+}
+
+/**
+ * The I/O thread
+ *
+ * @description sleeps in poll(2) until the UART has data or room for
+ * pending frames, the wake event is signaled, the next register poll is
+ * due or a request expires
+ */
+static void *io_thread(void *arg)
+{
+    struct pollfd fds[2];
+    serial_io_tx_stats_t stats;
+    uint64_t now;
+    uint64_t due;
+    uint64_t count;
+    uint32_t period;
+    uint8_t reg;
+    int timeout_ms;
+    int ret;
+    uint32_t i;
+
+    (void)arg;
+
+    fds[1].fd = wake_fd;
+    fds[1].events = POLLIN;
+    reconnects = 0;
+
+    /* Every register is due at once, the greeting has to go out first */
+    if (uart >= 0) {
+        start_session(get_monotonic_us());
+    }
+
+    while (true) {
+
+        now = get_monotonic_us();
+
+        if (uart < 0) {
+            /* Link down: only the backoff timer and the wake event matter */
+            if (now >= reconnect_at && reconnect() == 0) {
+                continue;
+            }
+
+            timeout_ms = reconnect_at > now ? (int)((reconnect_at - now + 999) / 1000) : 0;
+            if (poll(&fds[1], 1, timeout_ms) > 0) {
+                if (read(wake_fd, &count, sizeof(count)) < 0 && errno != EAGAIN) {
+                    perror("serial_io wake");
+                }
+                if (__atomic_load_n(&stop_requested, __ATOMIC_ACQUIRE)) {
+                    break;
+                }
+            }
+            continue;
+        }
+
+        dps150_transact_tick(&transact, now);
+        flush_capture(now);
+
+        period = __atomic_load_n(&poll_period_ms, __ATOMIC_RELAXED);
+        if (period != sched_base_ms) {
+            dps150_sched_set_base(&sched, period);
+            sched_base_ms = period;
+        }
+
+        /* Polls are issued on schedule, without waiting for the previous reply */
+        while (dps150_transact_can_send(&transact) && (reg = dps150_sched_next(&sched, now)) != 0) {
+            dps150_transact_request(&transact, reg, now);
+        }
+
+        if (tx_pending() && flush_tx() != 0) {
+            if (link_failed(errno)) {
+                break;
+            }
+            continue;
+        }
+
+        due = dps150_transact_next_deadline(&transact);
+        if (dps150_transact_can_send(&transact) && dps150_sched_next_deadline(&sched) < due) {
+            due = dps150_sched_next_deadline(&sched);
+        }
+        if (capture.file != NULL && capture_flush_at < due) {
+            due = capture_flush_at;
+        }
+
+        timeout_ms = due > now ? (int)((due - now + 999) / 1000) : 0;
+
+        fds[0].fd = uart;
+        fds[0].events = POLLIN | (tx_pending() ? POLLOUT : 0);
+
+        ret = poll(fds, 2, timeout_ms);
+        if (ret < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            publish_error(errno);
+            break;
+        }
+
+        if (fds[1].revents & POLLIN) {
+            if (read(wake_fd, &count, sizeof(count)) < 0 && errno != EAGAIN) {
+                perror("serial_io wake");
+            }
+            if (__atomic_load_n(&stop_requested, __ATOMIC_ACQUIRE)) {
+                break;
+            }
+        }
+
+        if (fds[0].revents & (POLLERR | POLLHUP | POLLNVAL)) {
+            if (link_failed(EIO)) {
+                break;
+            }
+            continue;
+        }
+
+        if (fds[0].revents & POLLIN) {
+            ssize_t bytes_read = read(uart, rx_chunk, sizeof(rx_chunk));
+
+            if (bytes_read > 0) {
+                capture_write(&capture, CAPTURE_DIR_RX, rx_chunk, bytes_read, get_monotonic_us());
+                dps150_parser_feed(&parser, rx_chunk, bytes_read);
+            } else if (bytes_read == 0 || (errno != EAGAIN && errno != EINTR)) {
+                if (link_failed(bytes_read == 0 ? EIO : errno)) {
+                    break;
+                }
+            }
+        }
+    }
+
+    printf("Serial I/O: %u frames, %u checksum errors, %u bytes skipped, %u dropped\n",
+           parser.frames, parser.checksum_errors, parser.skipped, dropped);
+
+    if (transact.completed > 0) {
+        printf("Serial I/O: %u replies, %u retries, %u failed, RTT min/avg/max %u/%u/%u us\n",
+               transact.completed, transact.retries, transact.failed,
+               transact.rtt_min_us, (uint32_t)(transact.rtt_sum_us / transact.completed),
+               transact.rtt_max_us);
+    }
+
+    if (reconnects > 0) {
+        printf("Serial I/O: %u reconnections\n", reconnects);
+    }
+
+    printf("Serial I/O: polls per register");
+    for (i = 0; i < DPS150_SCHED_ENTRY_CNT; i++) {
+        printf(" %u:%u", sched.entries[i].reg, sched.entries[i].polls);
+    }
+    printf("\n");
+
+    serial_io_get_tx_stats(&stats);
+    if (stats.frames > 0) {
+        printf("Serial I/O: %u frames queued in %u writes, max depth %u, "
+               "write latency avg/max %u/%u us\n",
+               stats.frames, stats.batches, stats.depth_max,
+               (uint32_t)(stats.latency_sum_us / stats.frames), stats.latency_max_us);
+    }
+
+    return NULL;
+}
+
+/**
+ * Publish a frame decoded by the parser
+ *
+ * @param cmd the command byte of the frame
+ * @param type the register type
+ * @param payload the payload
+ * @param len the payload length
+ * @param user_data unused
+ */
+static void frame_cb(uint8_t cmd, uint8_t type, const uint8_t *payload, uint8_t len,
+                     void *user_data)
+{
+    serial_io_evt_t *evt;
+    uint64_t now;
+    int32_t rtt;
+
+    (void)user_data;
+
+    if (cmd != CMD_GET) {
+        return;
+    }
+
+    now = get_monotonic_us();
+    link_healthy = true;
+    rtt = dps150_transact_complete(&transact, type, now);
+    dps150_sched_on_reply(&sched, type, payload, len);
+
+    evt = spsc_ring_reserve(&ring);
+
+    /* A replay must not lose frames, it waits for the consumer instead */
+    while (evt == NULL && replaying && !__atomic_load_n(&stop_requested, __ATOMIC_ACQUIRE)) {
+        usleep(1000);
+        evt = spsc_ring_reserve(&ring);
+    }
+
+    if (evt != NULL) {
+        evt->timestamp_us = now;
+        evt->rtt_us = rtt;
+        evt->evt = SERIAL_IO_EVT_FRAME;
+        evt->err = 0;
+        evt->type = type;
+        evt->len = len;
+        memcpy(evt->data, payload, len);
+        spsc_ring_publish(&ring);
+        signal_event();
+    } else {
+        dropped++;
+    }
+}
+
+/**
+ * Stage the CMD_GET request of a register, it is written by the next flush
+ *
+ * @param type the register type
+ * @param user_data unused
+ * @return 0 on success, -1 if too many requests are waiting
+ */
+static int send_get(uint8_t type, void *user_data)
+{
+    (void)user_data;
+
+    if (get_cnt == GET_STAGE_SIZE) {
+        return -1;
+    }
+
+    if (type == DPS150_REG_ALL) {
+        memcpy(get_stage[get_cnt], dps150_frame_get_all, GET_FRAME_LEN);
+    } else {
+        dps150_encode_get(get_stage[get_cnt], GET_FRAME_LEN, type);
+    }
+    get_cnt++;
+
+    return 0;
+}
+
+/**
+ * Check if frames are waiting to be written
+ * @return true if the staged requests or the transmit queue are not empty
+ */
+static bool tx_pending(void)
+{
+    return get_cnt > 0 || spsc_ring_peek(&tx_ring) != NULL;
+}
+
+/**
+ * Write the staged requests and the queued frames with one writev(2)
+ *
+ * @return 0 on success or if the port is busy, -1 if the port failed
+ */
+static int flush_tx(void)
+{
+    struct iovec iov[TX_BATCH_MAX];
+    tx_slot_t *slot;
+    ssize_t written;
+    size_t rem;
+    uint64_t now;
+    uint32_t latency;
+    uint32_t frames;
+    int cnt = 0;
+    uint32_t i;
+
+    for (i = 0; i < get_cnt; i++) {
+        iov[cnt].iov_base = get_stage[i] + (i == 0 ? get_offset : 0);
+        iov[cnt].iov_len = GET_FRAME_LEN - (i == 0 ? get_offset : 0);
+        cnt++;
+    }
+
+    for (i = 0; cnt < TX_BATCH_MAX && (slot = spsc_ring_peek_at(&tx_ring, i)) != NULL; i++) {
+        iov[cnt].iov_base = slot->data + (i == 0 ? tx_offset : 0);
+        iov[cnt].iov_len = slot->len - (i == 0 ? tx_offset : 0);
+        cnt++;
+    }
+
+    written = writev(uart, iov, cnt);
+    if (written < 0) {
+        if (errno == EAGAIN || errno == EINTR) {
+            return 0;
+        }
+        return -1;
+    }
+
+    STAT_ADD(batches, 1);
+    STAT_ADD(bytes, (uint32_t)written);
+
+    now = get_monotonic_us();
+
+    if (capture.file != NULL) {
+        capture_tx(iov, cnt, (size_t)written, now);
+    }
+
+    /* The staged requests come first in the batch, their round trip starts now */
+    while (written > 0 && get_cnt > 0) {
+        rem = GET_FRAME_LEN - get_offset;
+        if ((size_t)written < rem) {
+            get_offset += written;
+            return 0;
+        }
+        written -= rem;
+        get_offset = 0;
+        dps150_transact_written(&transact, get_stage[0][2], now);
+        get_cnt--;
+        memmove(get_stage[0], get_stage[1], get_cnt * GET_FRAME_LEN);
+    }
+
+    frames = 0;
+
+    while (written > 0 && (slot = spsc_ring_peek(&tx_ring)) != NULL) {
+        rem = slot->len - tx_offset;
+        if ((size_t)written < rem) {
+            tx_offset += written;
+            break;
+        }
+        written -= rem;
+        tx_offset = 0;
+
+        /* Read the written register back, the status block if it is not polled alone */
+        if (slot->data[1] == CMD_SET && dps150_sched_demand(&sched, slot->data[2]) != 0) {
+            dps150_sched_demand(&sched, DPS150_REG_ALL);
+        }
+
+        latency = (uint32_t)(now - slot->enqueue_us);
+        STAT_ADD(latency_sum_us, latency);
+        STAT_MAX(latency_max_us, latency);
+        frames++;
+
+        spsc_ring_release(&tx_ring);
+    }
+
+    STAT_ADD(frames, frames);
+
+    return 0;
+}
+
+/**
+ * Tell the LVGL thread that the port failed
+ *
+ * @param err the errno value describing the failure
+ */
+static void publish_error(int err)
+{
+    publish_status(SERIAL_IO_EVT_ERROR, err);
+}
+
+/**
+ * Publish an event without payload
+ *
+ * @param type SERIAL_IO_EVT_ERROR or SERIAL_IO_EVT_END
+ * @param err the errno value describing a failure
+ */
+static void publish_status(uint8_t type, int err)
+{
+    serial_io_evt_t *evt;
+
+    /* The event must not be lost, wait for the consumer if the ring is full */
+    while ((evt = spsc_ring_reserve(&ring)) == NULL) {
+        if (__atomic_load_n(&stop_requested, __ATOMIC_ACQUIRE)) {
+            return;
+        }
+        usleep(10000);
+    }
+
+    evt->timestamp_us = get_monotonic_us();
+    evt->rtt_us = -1;
+    evt->evt = type;
+    evt->err = err;
+    evt->type = 0;
+    evt->len = 0;
+    spsc_ring_publish(&ring);
+    signal_event();
+}
+
+/**
+ * The replay thread
+ *
+ * @description feeds the received bytes of a capture to the parser,
+ * keeping the recorded timing divided by the replay speed, or as fast
+ * as the consumer releases events when the speed is 0
+ */
+static void *replay_thread(void *arg)
+{
+    struct pollfd pfd;
+    capture_record_t rec;
+    uint64_t start;
+    uint64_t elapsed = 0;
+    uint64_t now;
+    uint64_t count;
+    uint64_t target;
+
+    (void)arg;
+
+    pfd.fd = wake_fd;
+    pfd.events = POLLIN;
+    start = get_monotonic_us();
+
+    while (!__atomic_load_n(&stop_requested, __ATOMIC_ACQUIRE)) {
+        if (capture_read(&capture, &rec) != 0) {
+            publish_status(SERIAL_IO_EVT_END, 0);
+            break;
+        }
+
+        /* Host requests are not replayed, the parser only sees the device */
+        if (rec.dir != CAPTURE_DIR_RX) {
+            elapsed += rec.delta_us;
+            continue;
+        }
+
+        elapsed += rec.delta_us;
+        if (replay_speed > 0.0f) {
+            target = start + (uint64_t)((double)elapsed / replay_speed);
+
+            /* Sleep until the record is due, the wake event only signals a stop */
+            while ((now = get_monotonic_us()) < target &&
+                   !__atomic_load_n(&stop_requested, __ATOMIC_ACQUIRE)) {
+                if (poll(&pfd, 1, (int)((target - now + 999) / 1000)) > 0 &&
+                    read(wake_fd, &count, sizeof(count)) < 0 && errno != EAGAIN) {
+                    perror("serial_io wake");
+                }
+            }
+        }
+
+        dps150_parser_feed(&parser, rec.data, rec.len);
+    }
+
+    printf("Serial I/O: replayed %u records, %u frames, %u checksum errors in %u ms\n",
+           capture.records, parser.frames, parser.checksum_errors,
+           (uint32_t)((get_monotonic_us() - start) / 1000));
+
+    return NULL;
+}
+
+/**
+ * Record the bytes of a writev(2) batch in the capture
+ *
+ * @param iov the batch
+ * @param cnt the number of entries in iov
+ * @param written the bytes actually written
+ * @param now the monotonic time of the write
+ */
+static void capture_tx(const struct iovec *iov, int cnt, size_t written, uint64_t now)
+{
+    size_t len = 0;
+    size_t n;
+    int i;
+
+    for (i = 0; i < cnt && len < written; i++) {
+        n = iov[i].iov_len < written - len ? iov[i].iov_len : written - len;
+        memcpy(capture_buf + len, iov[i].iov_base, n);
+        len += n;
+    }
+
+    capture_write(&capture, CAPTURE_DIR_TX, capture_buf, len, now);
+}
+
+/**
+ * Wake the LVGL thread after publishing an event
+ *
+ * @description the counter of the eventfd saturates rather than blocks,
+ * the consumer drains the whole ring on each wakeup
+ */
+static void signal_event(void)
+{
+    uint64_t one = 1;
+
+    if (event_fd >= 0 && write(event_fd, &one, sizeof(one)) < 0 && errno != EAGAIN) {
+        perror("serial_io signal");
+    }
+}
+
+/**
+ * Handle a failure of the port
+ *
+ * @description without reconnection the LVGL thread is told and the
+ * thread exits. Otherwise the port is closed, the requests in flight
+ * and a partially written frame are dropped, the queued frames are
+ * kept for the next link, and the first attempt is scheduled
+ * @param err the errno value describing the failure
+ * @return true if the thread has to exit
+ */
+static bool link_failed(int err)
+{
+    if (!reconnect_enabled) {
+        publish_error(err);
+        return true;
+    }
+
+    printf("Serial I/O: %s: %s, reconnecting\n", reconnect_path, strerror(err));
+
+    close(uart);
+    uart = -1;
+
+    /* Nothing is recorded while the link is down */
+    capture_flush_at = 0;
+    flush_capture(get_monotonic_us());
+
+    dps150_transact_reset(&transact);
+    dps150_parser_reset(&parser);
+    get_cnt = 0;
+    get_offset = 0;
+    if (tx_offset > 0) {
+        spsc_ring_release(&tx_ring);
+        tx_offset = 0;
+    }
+
+    /* Only a link that worked starts over from the shortest delay, a port
+     * failing as soon as it opens keeps backing off */
+    if (link_healthy || reconnect_delay_ms == 0) {
+        reconnect_delay_ms = SERIAL_IO_RECONNECT_MIN_MS;
+        reconnect_at = get_monotonic_us() + reconnect_delay_ms * 1000u;
+    } else {
+        backoff(get_monotonic_us());
+    }
+    link_healthy = false;
+
+    publish_status(SERIAL_IO_EVT_LINK_DOWN, err);
+    return false;
+}
+
+/**
+ * Try to reopen the port, the next attempt is scheduled on failure
+ *
+ * @return 0 if the port was reopened, -1 otherwise
+ */
+static int reconnect(void)
+{
+    char path[SERIAL_IO_PATH_MAX];
+    const char *target = reconnect_path;
+    uint64_t now;
+    int fd;
+
+    /* The device may come back under another name */
+    if (port_watch_find(reconnect_serial, path, sizeof(path)) == 0) {
+        target = path;
+    }
+
+    fd = dps150_probe_open(target);
+    now = get_monotonic_us();
+
+    if (fd < 0) {
+        backoff(now);
+        return -1;
+    }
+
+    printf("Serial I/O: reconnected to %s\n", target);
+    uart = fd;
+    reconnects++;
+
+    start_session(now);
+    dps150_sched_restart(&sched, now);
+    publish_status(SERIAL_IO_EVT_LINK_UP, 0);
+
+    return 0;
+}
+
+/**
+ * Double the reconnection delay, up to the maximum, and schedule the next attempt
+ * @param now the current time
+ */
+static void backoff(uint64_t now)
+{
+    reconnect_delay_ms *= 2;
+    if (reconnect_delay_ms > SERIAL_IO_RECONNECT_MAX_MS) {
+        reconnect_delay_ms = SERIAL_IO_RECONNECT_MAX_MS;
+    }
+    reconnect_at = now + reconnect_delay_ms * 1000u;
+}
+
+/**
+ * Write the buffered records of the capture to the file once a second,
+ * so a crash or a kill loses at most the last second
+ * @param now the current time
+ */
+static void flush_capture(uint64_t now)
+{
+    if (capture.file == NULL || now < capture_flush_at) {
+        return;
+    }
+
+    fflush(capture.file);
+    capture_flush_at = now + CAPTURE_FLUSH_MS * 1000u;
+}
+
+/**
+ * Write the session start frame, ahead of the first poll of a connection
+ * @param now the current time, for the capture
+ */
+static void start_session(uint64_t now)
+{
+    if (write(uart, dps150_frame_session_start, sizeof(dps150_frame_session_start)) > 0) {
+        capture_write(&capture, CAPTURE_DIR_TX, dps150_frame_session_start,
+                      sizeof(dps150_frame_session_start), now);
+    }
+}
@@ -0,0 +1,225 @@
+/**
+ * @file serial_io.h
+ *
+ * Dedicated serial I/O thread
+ *
+ * The thread owns the reading side of the UART, blocks in poll(2) on
+ * the file descriptor and decodes frames as soon as bytes arrive.
+ * Decoded frames are handed to the LVGL thread through a lock-free
+ * single-producer/single-consumer ring which is drained once per frame.
+ *
+ * The status polls are issued through the pipelined request engine,
+ * see dps150_transact.h, the next poll does not wait for the previous
+ * reply.
+ *
+ * Commands are queued by the LVGL thread into a preallocated frame pool
+ * and written asynchronously by the I/O thread, queuing never blocks.
+ *
+ * When reconnection is enabled a failing port is closed and reopened
+ * by the thread with an exponential backoff, the LVGL thread is only
+ * told when the link goes down and comes back.
+ *
+ */
+
+#ifndef SERIAL_IO_H
+#define SERIAL_IO_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include <stddef.h>
+#include <stdint.h>
+
+#include "dps150_proto.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/* Number of events the ring can hold, must be a power of two */
+#define SERIAL_IO_RING_SIZE 64
+
+/* Number of frames the transmit queue can hold, must be a power of two */
+#define SERIAL_IO_TX_QUEUE_SIZE 16
+
+/* Default period of the fastest polled register, the others are multiples of it */
+#define SERIAL_IO_POLL_PERIOD_MS 50
+
+/* Longest accepted poll period, the slowest register is polled 100 times less often */
+#define SERIAL_IO_POLL_PERIOD_MAX_MS 10000
+
+/* Delay before the first reconnection attempt, doubled up to the maximum
+ * until the device answers again */
+#define SERIAL_IO_RECONNECT_MIN_MS 100
+#define SERIAL_IO_RECONNECT_MAX_MS 5000
+
+#define SERIAL_IO_PATH_MAX 128
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+typedef enum {
+    SERIAL_IO_EVT_FRAME,    /* A complete frame was received */
+    SERIAL_IO_EVT_ERROR,    /* The port failed, the thread has stopped reading */
+    SERIAL_IO_EVT_END,      /* The replayed capture is over, the thread has stopped */
+    SERIAL_IO_EVT_LINK_DOWN,    /* The port failed, the thread is reconnecting */
+    SERIAL_IO_EVT_LINK_UP,      /* The port was reopened, polling resumed */
+} serial_io_evt_type_t;
+
+/* One entry of the ring */
+typedef struct {
+    uint64_t timestamp_us;          /* Monotonic time of reception */
+    int32_t rtt_us;                 /* Round-trip latency of the request, -1 if unknown */
+    int err;                        /* errno value for SERIAL_IO_EVT_ERROR and LINK_DOWN */
+    uint8_t evt;                    /* serial_io_evt_type_t */
+    uint8_t type;                   /* Register type of the frame */
+    uint8_t len;                    /* Payload length */
+    uint8_t data[DPS150_PAYLOAD_MAX];
+} serial_io_evt_t;
+
+/* Transmit queue metrics, since the thread was started */
+typedef struct {
+    uint32_t frames;                /* Queued frames written */
+    uint32_t batches;               /* writev(2) calls */
+    uint32_t bytes;                 /* Bytes written, status requests included */
+    uint32_t rejected;              /* Frames refused because the queue was full */
+    uint32_t depth;                 /* Frames currently queued */
+    uint32_t depth_max;             /* Highest queue depth */
+    uint64_t latency_sum_us;        /* Sum of the queue to wire latencies */
+    uint32_t latency_max_us;
+} serial_io_tx_stats_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Start the I/O thread on an open UART
+ *
+ * @description the thread writes the session start frame before the
+ * first register poll
+ * @param fd the UART file descriptor, opened non-blocking
+ * @return 0 on success, -1 on error
+ */
+int serial_io_start(int fd);
+
+/**
+ * Start the I/O thread on a capture file instead of a UART
+ *
+ * @param path the capture file
+ * @param speed 1 replays in real time, 10 ten times faster, 0 as fast
+ * as the events are consumed
+ * @return 0 on success, -1 on error
+ */
+int serial_io_start_replay(const char *path, float speed);
+
+/**
+ * Record the traffic of the next connections to a capture file - call
+ * before serial_io_start
+ * @param path the file, created on the first connection, NULL to disable
+ */
+void serial_io_set_capture(const char *path);
+
+/**
+ * Flush and close the capture file - call after serial_io_stop, e.g. at exit
+ * @description the I/O thread flushes the capture once a second, closing
+ * it writes the rest; the file is not recreated by later connections
+ */
+void serial_io_close_capture(void);
+
+/**
+ * Reopen the port when it fails instead of stopping - call before
+ * serial_io_start
+ * @description the port is looked up again by its USB serial number,
+ * it may come back under another name; without a serial number, or if
+ * it is not found, the same path is reopened
+ * @param path the device path, NULL disables reconnection
+ * @param usb_serial the USB serial number, NULL or empty if unknown
+ */
+void serial_io_set_reconnect(const char *path, const char *usb_serial);
+
+/**
+ * Stop the I/O thread and wait for it to exit
+ * @description the file descriptor is not closed, it may have changed
+ * if the thread reconnected, see serial_io_get_fd
+ */
+void serial_io_stop(void);
+
+/**
+ * Get the file descriptor of the port - call after serial_io_stop
+ * @return the descriptor, -1 if the thread closed it while reconnecting
+ */
+int serial_io_get_fd(void);
+
+/**
+ * Get the oldest pending event - LVGL thread only
+ * @return the event or NULL if there is none
+ */
+serial_io_evt_t *serial_io_peek(void);
+
+/**
+ * Release the event returned by serial_io_peek - LVGL thread only
+ */
+void serial_io_release(void);
+
+/**
+ * Get a file descriptor that becomes readable when events are published
+ *
+ * @description created on the first call and kept across connections,
+ * so the run loop can watch it once; call it before serial_io_start.
+ * Read its counter before draining the events with serial_io_peek -
+ * LVGL thread only
+ * @return the eventfd, -1 if it cannot be created
+ */
+int serial_io_get_event_fd(void);
+
+/**
+ * Change the period of the fastest polled register, the others keep
+ * their ratio to it
+ * @param period_ms the new period, 0 is ignored, longer than
+ * SERIAL_IO_POLL_PERIOD_MAX_MS is clamped
+ */
+void serial_io_set_poll_period(uint32_t period_ms);
+
+/**
+ * Queue a frame for transmission - LVGL thread only
+ *
+ * @param data the complete frame
+ * @param len the frame length
+ * @return 0 on success, -1 if the thread is not running or the queue is full
+ */
+int serial_io_send(const uint8_t *data, size_t len);
+
+/**
+ * Get the storage of the next transmit slot to encode a frame in place - LVGL thread only
+ * @return DPS150_FRAME_MAX bytes of storage, NULL if the thread is not
+ * running or the queue is full
+ */
+uint8_t *serial_io_tx_reserve(void);
+
+/**
+ * Queue the frame encoded in the slot returned by serial_io_tx_reserve - LVGL thread only
+ * @param len the frame length, 0 leaves the slot free
+ */
+void serial_io_tx_commit(size_t len);
+
+/**
+ * Get a snapshot of the transmit queue metrics
+ * @param stats filled with the current values
+ */
+void serial_io_get_tx_stats(serial_io_tx_stats_t *stats);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*SERIAL_IO_H*/
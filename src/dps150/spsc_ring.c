@@ -0,0 +1,123 @@
+/**
+ * @file spsc_ring.c
+ *
+ * Lock-free single-producer/single-consumer ring of fixed size slots
+ *
+ * head and tail are free running counters, the producer only stores
+ * head and the consumer only stores tail. The acquire/release pairs
+ * order the slot contents with respect to the index updates.
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include <string.h>
+
+#include "spsc_ring.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+int spsc_ring_init(spsc_ring_t *ring, void *storage, size_t slot_size, uint32_t slot_cnt)
+{
+    if (slot_cnt == 0 || (slot_cnt & (slot_cnt - 1)) != 0) {
+        return -1;
+    }
+
+    memset(ring, 0, sizeof(*ring));
+    ring->slots = storage;
+    ring->slot_size = slot_size;
+    ring->mask = slot_cnt - 1;
+
+    return 0;
+}
+
+void spsc_ring_reset(spsc_ring_t *ring)
+{
+    __atomic_store_n(&ring->head, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&ring->tail, 0, __ATOMIC_RELAXED);
+}
+
+void *spsc_ring_reserve(spsc_ring_t *ring)
+{
+    uint32_t head = __atomic_load_n(&ring->head, __ATOMIC_RELAXED);
+    uint32_t tail = __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE);
+
+    if (head - tail > ring->mask) {
+        return NULL;
+    }
+
+    return ring->slots + (size_t)(head & ring->mask) * ring->slot_size;
+}
+
+void spsc_ring_publish(spsc_ring_t *ring)
+{
+    uint32_t head = __atomic_load_n(&ring->head, __ATOMIC_RELAXED);
+
+    __atomic_store_n(&ring->head, head + 1, __ATOMIC_RELEASE);
+}
+
+void *spsc_ring_peek(spsc_ring_t *ring)
+{
+    uint32_t tail = __atomic_load_n(&ring->tail, __ATOMIC_RELAXED);
+    uint32_t head = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE);
+
+    if (head == tail) {
+        return NULL;
+    }
+
+    return ring->slots + (size_t)(tail & ring->mask) * ring->slot_size;
+}
+
+void *spsc_ring_peek_at(spsc_ring_t *ring, uint32_t index)
+{
+    uint32_t tail = __atomic_load_n(&ring->tail, __ATOMIC_RELAXED);
+    uint32_t head = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE);
+
+    if (head - tail <= index) {
+        return NULL;
+    }
+
+    return ring->slots + (size_t)((tail + index) & ring->mask) * ring->slot_size;
+}
+
+void spsc_ring_release(spsc_ring_t *ring)
+{
+    uint32_t tail = __atomic_load_n(&ring->tail, __ATOMIC_RELAXED);
+
+    __atomic_store_n(&ring->tail, tail + 1, __ATOMIC_RELEASE);
+}
+
+uint32_t spsc_ring_count(const spsc_ring_t *ring)
+{
+    uint32_t head = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE);
+    uint32_t tail = __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE);
+
+    return head - tail;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
@@ -0,0 +1,120 @@
+/**
+ * @file spsc_ring.h
+ *
+ * Lock-free single-producer/single-consumer ring of fixed size slots
+ *
+ * One thread reserves and publishes slots, another thread peeks and
+ * releases them. Slots are used in place so no data is copied between
+ * the two sides. The slot count must be a power of two.
+ *
+ */
+
+#ifndef SPSC_RING_H
+#define SPSC_RING_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/* Keeps the producer and consumer indexes on separate cache lines */
+#define SPSC_RING_CACHE_LINE 64
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+typedef struct {
+    uint8_t *slots;         /* Caller provided storage, slot_size * slot_cnt bytes */
+    size_t slot_size;
+    uint32_t mask;          /* slot_cnt - 1 */
+
+    uint32_t head;          /* Written by the producer only */
+    uint8_t pad0[SPSC_RING_CACHE_LINE - sizeof(uint32_t)];
+
+    uint32_t tail;          /* Written by the consumer only */
+    uint8_t pad1[SPSC_RING_CACHE_LINE - sizeof(uint32_t)];
+} spsc_ring_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Initialize a ring over caller provided storage
+ *
+ * @param ring the ring to initialize
+ * @param storage memory for slot_cnt slots of slot_size bytes
+ * @param slot_size size of one slot in bytes
+ * @param slot_cnt number of slots, must be a power of two
+ * @return 0 on success, -1 if slot_cnt is not a power of two
+ */
+int spsc_ring_init(spsc_ring_t *ring, void *storage, size_t slot_size, uint32_t slot_cnt);
+
+/**
+ * Drop every published slot - only safe while neither side is running
+ * @param ring the ring to reset
+ */
+void spsc_ring_reset(spsc_ring_t *ring);
+
+/**
+ * Producer: get the next free slot
+ * @param ring the ring
+ * @return pointer to the slot to fill, NULL if the ring is full
+ */
+void *spsc_ring_reserve(spsc_ring_t *ring);
+
+/**
+ * Producer: make the slot returned by spsc_ring_reserve visible to the consumer
+ * @param ring the ring
+ */
+void spsc_ring_publish(spsc_ring_t *ring);
+
+/**
+ * Consumer: get the oldest published slot
+ * @param ring the ring
+ * @return pointer to the slot, NULL if the ring is empty
+ */
+void *spsc_ring_peek(spsc_ring_t *ring);
+
+/**
+ * Consumer: get a published slot without consuming the ones before it
+ * @param ring the ring
+ * @param index 0 for the oldest published slot, 1 for the next one...
+ * @return pointer to the slot, NULL if fewer slots are published
+ */
+void *spsc_ring_peek_at(spsc_ring_t *ring, uint32_t index);
+
+/**
+ * Consumer: hand the slot returned by spsc_ring_peek back to the producer
+ * @param ring the ring
+ */
+void spsc_ring_release(spsc_ring_t *ring);
+
+/**
+ * Number of published slots not yet released - approximate when
+ * called concurrently with the other side
+ * @param ring the ring
+ * @return the number of used slots
+ */
+uint32_t spsc_ring_count(const spsc_ring_t *ring);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*SPSC_RING_H*/
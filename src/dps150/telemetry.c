@@ -0,0 +1,326 @@
+/**
+ * @file telemetry.c
+ *
+ * Long-duration telemetry store
+ *
+ * Sample n lands in bucket n >> (3 * level) of each level. A bucket is
+ * cleared by its first sample, so the open bucket of every level is
+ * always up to date and nothing is rebuilt when a query runs.
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include <string.h>
+
+#include "telemetry.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void bucket_add(telemetry_bucket_t *bucket, int32_t value);
+static void bucket_merge(telemetry_bucket_t *acc, const telemetry_bucket_t *bucket);
+static void merge_range(const telemetry_ring_t *ring, uint64_t first, uint64_t end,
+                        telemetry_bucket_t *acc);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/* Field shown by each channel */
+static const dps150_field_t channel_fields[_TELEMETRY_CH_CNT] = {
+    [TELEMETRY_CH_VOLTAGE] = DPS150_FIELD_OUT_VOLTAGE,
+    [TELEMETRY_CH_CURRENT] = DPS150_FIELD_OUT_CURRENT,
+    [TELEMETRY_CH_POWER] = DPS150_FIELD_OUT_POWER,
+    [TELEMETRY_CH_TEMPERATURE] = DPS150_FIELD_TEMPERATURE,
+    [TELEMETRY_CH_INPUT_VOLTAGE] = DPS150_FIELD_INPUT_VOLTAGE,
+};
+
+/**********************
+ *      MACROS
+ **********************/
+
+/* Shift from a sample number to its bucket number in a level */
+#define LEVEL_SHIFT(level) (((level) + 1) * TELEMETRY_FANOUT_SHIFT)
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+int telemetry_ring_init(telemetry_ring_t *ring, uint64_t *storage, uint32_t capacity)
+{
+    uint64_t *words = storage;
+    uint32_t level;
+
+    if (capacity < TELEMETRY_CAPACITY_MIN || (capacity & (capacity - 1)) != 0) {
+        return -1;
+    }
+
+    memset(ring, 0, sizeof(*ring));
+    ring->mask = capacity - 1;
+
+    /* Values with their mirror, then times */
+    ring->values = (int32_t *)words;
+    ring->time_ms = (uint32_t *)(ring->values + capacity + TELEMETRY_WINDOW_MAX);
+    words += capacity + TELEMETRY_WINDOW_MAX / 2;
+
+    for (level = 0; level < TELEMETRY_LEVELS; level++) {
+        ring->levels[level] = (telemetry_bucket_t *)words;
+        words += TELEMETRY_LEVEL_WORDS(capacity, level);
+    }
+
+    telemetry_ring_reset(ring);
+    return 0;
+}
+
+void telemetry_ring_reset(telemetry_ring_t *ring)
+{
+    uint32_t i;
+
+    ring->count = 0;
+    ring->t0_us = 0;
+
+    /* Windows reaching before the first sample start at the end of the ring */
+    for (i = ring->mask + 1 - TELEMETRY_WINDOW_MAX; i <= ring->mask; i++) {
+        ring->values[i] = TELEMETRY_NONE;
+    }
+}
+
+void telemetry_ring_append(telemetry_ring_t *ring, int32_t value, uint64_t now_us)
+{
+    uint64_t seq = ring->count;
+    uint32_t idx = (uint32_t)seq & ring->mask;
+    telemetry_bucket_t *bucket;
+    uint32_t shift;
+    uint32_t level;
+
+    if (seq == 0) {
+        ring->t0_us = now_us;
+    }
+
+    ring->values[idx] = value;
+    if (idx < TELEMETRY_WINDOW_MAX) {
+        ring->values[ring->mask + 1 + idx] = value;
+    }
+    ring->time_ms[idx] = (uint32_t)((now_us - ring->t0_us) / 1000u);
+
+    for (level = 0; level < TELEMETRY_LEVELS; level++) {
+        shift = LEVEL_SHIFT(level);
+        bucket = &ring->levels[level][(seq >> shift) & (ring->mask >> shift)];
+
+        /* First sample of the bucket: the slot still holds an old one */
+        if ((seq & ((UINT64_C(1) << shift) - 1)) == 0) {
+            memset(bucket, 0, sizeof(*bucket));
+        }
+        bucket_add(bucket, value);
+    }
+
+    ring->count = seq + 1;
+}
+
+int32_t telemetry_ring_get(const telemetry_ring_t *ring, uint64_t seq)
+{
+    if (seq >= ring->count || seq < telemetry_ring_oldest(ring)) {
+        return TELEMETRY_NONE;
+    }
+
+    return ring->values[(uint32_t)seq & ring->mask];
+}
+
+const int32_t *telemetry_ring_window(const telemetry_ring_t *ring, uint32_t len)
+{
+    /* Wraps to the end of the ring before the first sample */
+    return &ring->values[(uint32_t)(ring->count - len) & ring->mask];
+}
+
+uint64_t telemetry_ring_find(const telemetry_ring_t *ring, uint64_t time_us)
+{
+    uint64_t lo = telemetry_ring_oldest(ring);
+    uint64_t hi = ring->count;
+    uint64_t mid;
+    uint32_t time_ms;
+
+    if (ring->count == 0 || time_us <= ring->t0_us) {
+        return lo;
+    }
+
+    time_ms = (uint32_t)((time_us - ring->t0_us) / 1000u);
+
+    /* Reception times never decrease */
+    while (lo < hi) {
+        mid = lo + (hi - lo) / 2;
+        if (ring->time_ms[(uint32_t)mid & ring->mask] < time_ms) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+
+    return lo;
+}
+
+void telemetry_ring_decimate(const telemetry_ring_t *ring, uint64_t first, uint64_t end,
+                             telemetry_col_t *cols, uint32_t col_cnt)
+{
+    telemetry_bucket_t acc;
+    uint64_t oldest = telemetry_ring_oldest(ring);
+    uint64_t len;
+    uint64_t col_first;
+    uint64_t col_end;
+    uint32_t c;
+
+    if (first < oldest) {
+        first = oldest;
+    }
+    if (end > ring->count) {
+        end = ring->count;
+    }
+    len = end > first ? end - first : 0;
+
+    for (c = 0; c < col_cnt; c++) {
+        col_first = first + len * c / col_cnt;
+        col_end = first + len * (c + 1) / col_cnt;
+
+        /* Fewer samples than columns: a sample spans several columns */
+        if (col_end == col_first && col_first < end) {
+            col_end = col_first + 1;
+        }
+
+        memset(&acc, 0, sizeof(acc));
+        merge_range(ring, col_first, col_end, &acc);
+
+        if (acc.cnt == 0) {
+            cols[c].min = TELEMETRY_NONE;
+            cols[c].max = TELEMETRY_NONE;
+            cols[c].mean = TELEMETRY_NONE;
+        } else {
+            cols[c].min = acc.min;
+            cols[c].max = acc.max;
+            cols[c].mean = (int32_t)(acc.sum / (int64_t)acc.cnt);
+        }
+    }
+}
+
+int32_t telemetry_value_of(const dps150_status_t *status, telemetry_ch_t ch)
+{
+    float value = dps150_regs_get_float(status, channel_fields[ch]) * TELEMETRY_SCALE;
+
+    return (int32_t)(value < 0 ? value - 0.5f : value + 0.5f);
+}
+
+void telemetry_record(telemetry_ring_t *rings, const dps150_status_t *status, uint64_t fields,
+                      uint64_t now_us)
+{
+    uint32_t ch;
+
+    for (ch = 0; ch < _TELEMETRY_CH_CNT; ch++) {
+        if ((fields & DPS150_FIELD_BIT(channel_fields[ch])) == 0) {
+            continue;
+        }
+
+        telemetry_ring_append(&rings[ch], telemetry_value_of(status, ch), now_us);
+    }
+}
+
+void telemetry_mark_gap(telemetry_ring_t *rings, uint64_t now_us)
+{
+    uint32_t ch;
+
+    for (ch = 0; ch < _TELEMETRY_CH_CNT; ch++) {
+        telemetry_ring_append(&rings[ch], TELEMETRY_NONE, now_us);
+    }
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Add a sample to a bucket
+ * @param bucket the bucket
+ * @param value the value, gaps are not counted
+ */
+static void bucket_add(telemetry_bucket_t *bucket, int32_t value)
+{
+    if (value == TELEMETRY_NONE) {
+        return;
+    }
+
+    if (bucket->cnt == 0 || value < bucket->min) {
+        bucket->min = value;
+    }
+    if (bucket->cnt == 0 || value > bucket->max) {
+        bucket->max = value;
+    }
+    bucket->sum += value;
+    bucket->cnt++;
+}
+
+/**
+ * Merge a bucket into an accumulator
+ * @param acc the accumulator
+ * @param bucket the bucket to merge
+ */
+static void bucket_merge(telemetry_bucket_t *acc, const telemetry_bucket_t *bucket)
+{
+    if (bucket->cnt == 0) {
+        return;
+    }
+
+    if (acc->cnt == 0 || bucket->min < acc->min) {
+        acc->min = bucket->min;
+    }
+    if (acc->cnt == 0 || bucket->max > acc->max) {
+        acc->max = bucket->max;
+    }
+    acc->sum += bucket->sum;
+    acc->cnt += bucket->cnt;
+}
+
+/**
+ * Merge a range of kept samples into an accumulator
+ *
+ * @description walks the range with the largest complete bucket that
+ * starts at the current sample, so at most 2 * 7 buckets per level and
+ * 14 raw samples are visited
+ * @param ring the ring
+ * @param first the first sample, not older than telemetry_ring_oldest
+ * @param end the sample after the last one, at most count
+ * @param acc the accumulator
+ */
+static void merge_range(const telemetry_ring_t *ring, uint64_t first, uint64_t end,
+                        telemetry_bucket_t *acc)
+{
+    uint64_t span;
+    uint32_t shift;
+    int level;
+
+    while (first < end) {
+        for (level = TELEMETRY_LEVELS - 1; level >= 0; level--) {
+            shift = LEVEL_SHIFT(level);
+            span = UINT64_C(1) << shift;
+            if ((first & (span - 1)) == 0 && end - first >= span) {
+                break;
+            }
+        }
+
+        if (level < 0) {
+            bucket_add(acc, ring->values[(uint32_t)first & ring->mask]);
+            first++;
+            continue;
+        }
+
+        /* An aligned bucket that started after the oldest sample is still kept */
+        bucket_merge(acc, &ring->levels[level][(first >> shift) & (ring->mask >> shift)]);
+        first += span;
+    }
+}
@@ -0,0 +1,214 @@
+/**
+ * @file telemetry.h
+ *
+ * Long-duration telemetry store
+ *
+ * Every sample of a channel is kept at full resolution in a ring over
+ * caller provided storage. Next to the ring, a pyramid of min/max/mean
+ * buckets is maintained as samples arrive: a level n bucket covers
+ * 8^n samples. Reducing any window to one point per pixel column then
+ * costs O(columns), whatever the number of samples in the window.
+ *
+ * Values are integers in milli-units (mV, mA, mW, milli-degrees), so
+ * no resolution is lost to the charts' integer points. The first
+ * TELEMETRY_WINDOW_MAX values are mirrored past the end of the ring, so
+ * the latest samples are always one contiguous array a chart can use
+ * in place.
+ *
+ */
+
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include <stdint.h>
+
+#include "dps150_regs.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/* No sample, e.g. while the link is down. Same value as LV_CHART_POINT_NONE */
+#define TELEMETRY_NONE INT32_MAX
+
+/* Number of pyramid levels and samples merged into one bucket of the next level */
+#define TELEMETRY_LEVELS 5
+#define TELEMETRY_FANOUT_SHIFT 3
+
+/* Smallest ring, one bucket of the top level */
+#define TELEMETRY_CAPACITY_MIN (UINT32_C(1) << (TELEMETRY_LEVELS * TELEMETRY_FANOUT_SHIFT))
+
+/* Longest window of the latest samples, see telemetry_ring_window */
+#define TELEMETRY_WINDOW_MAX 1024
+
+/* Channel values are stored in thousandths of the device unit */
+#define TELEMETRY_SCALE 1000
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+typedef enum {
+    TELEMETRY_CH_VOLTAGE,
+    TELEMETRY_CH_CURRENT,
+    TELEMETRY_CH_POWER,
+    TELEMETRY_CH_TEMPERATURE,
+    TELEMETRY_CH_INPUT_VOLTAGE,
+    _TELEMETRY_CH_CNT
+} telemetry_ch_t;
+
+typedef struct {
+    int32_t min;
+    int32_t max;
+    int64_t sum;
+    uint32_t cnt;           /* Samples merged, TELEMETRY_NONE ones excluded */
+} telemetry_bucket_t;
+
+/* One reduced column, every member is TELEMETRY_NONE if it holds no sample */
+typedef struct {
+    int32_t min;
+    int32_t max;
+    int32_t mean;
+} telemetry_col_t;
+
+typedef struct {
+    int32_t *values;                    /* capacity + TELEMETRY_WINDOW_MAX values */
+    uint32_t *time_ms;                  /* Reception time, relative to t0_us */
+    telemetry_bucket_t *levels[TELEMETRY_LEVELS];
+    uint32_t mask;                      /* capacity - 1 */
+    uint64_t count;                     /* Samples appended since init */
+    uint64_t t0_us;                     /* Time of the first sample */
+} telemetry_ring_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Initialize an empty ring over caller provided storage
+ *
+ * @param ring the ring to initialize
+ * @param storage TELEMETRY_STORAGE_WORDS(capacity) 64-bit words
+ * @param capacity samples kept, a power of two of at least TELEMETRY_CAPACITY_MIN
+ * @return 0 on success, -1 if the capacity is not valid
+ */
+int telemetry_ring_init(telemetry_ring_t *ring, uint64_t *storage, uint32_t capacity);
+
+/**
+ * Drop every sample, the storage is kept
+ * @param ring the ring
+ */
+void telemetry_ring_reset(telemetry_ring_t *ring);
+
+/**
+ * Append a sample, the oldest one is overwritten when the ring is full
+ *
+ * @description updates the open bucket of every pyramid level, O(levels)
+ * @param ring the ring
+ * @param value the value in milli-units, TELEMETRY_NONE for a gap
+ * @param now_us monotonic time of the sample
+ */
+void telemetry_ring_append(telemetry_ring_t *ring, int32_t value, uint64_t now_us);
+
+/**
+ * Get a sample
+ * @param ring the ring
+ * @param seq the sequence number, between telemetry_ring_oldest and count - 1
+ * @return the value, TELEMETRY_NONE if the sample is a gap or no longer kept
+ */
+int32_t telemetry_ring_get(const telemetry_ring_t *ring, uint64_t seq);
+
+/**
+ * Get the latest samples as one array, oldest first
+ *
+ * @description the array lives in the ring and stays valid until
+ * capacity - len more samples are appended. Positions before the first
+ * sample read TELEMETRY_NONE
+ * @param ring the ring
+ * @param len number of samples, at most TELEMETRY_WINDOW_MAX
+ * @return the first of the len samples
+ */
+const int32_t *telemetry_ring_window(const telemetry_ring_t *ring, uint32_t len);
+
+/**
+ * Find the first sample received at or after a time
+ * @param ring the ring
+ * @param time_us monotonic time
+ * @return its sequence number, count if every kept sample is older
+ */
+uint64_t telemetry_ring_find(const telemetry_ring_t *ring, uint64_t time_us);
+
+/**
+ * Reduce a window to a fixed number of columns
+ *
+ * @description every column gets the exact min, max and mean of its
+ * share of the window, built from the largest pyramid buckets that fit
+ * @param ring the ring
+ * @param first sequence number of the first sample of the window
+ * @param end sequence number after the last one, clipped to count
+ * @param cols receives col_cnt columns
+ * @param col_cnt number of columns, e.g. the plot width in pixels
+ */
+void telemetry_ring_decimate(const telemetry_ring_t *ring, uint64_t first, uint64_t end,
+                             telemetry_col_t *cols, uint32_t col_cnt);
+
+/**
+ * Get the value of a channel in milli-units
+ * @param status the shadowed registers
+ * @param ch the channel
+ * @return the value, rounded to the nearest milli-unit
+ */
+int32_t telemetry_value_of(const dps150_status_t *status, telemetry_ch_t ch);
+
+/**
+ * Append the channels carried by a reply to their rings
+ *
+ * @description every reply is a sample even if the value did not
+ * change, so the time axis stays regular
+ * @param rings one ring per channel, indexed by telemetry_ch_t
+ * @param status the shadowed registers, already updated with the reply
+ * @param fields the fields of the reply, see dps150_regs_fields_of
+ * @param now_us monotonic time of the reply
+ */
+void telemetry_record(telemetry_ring_t *rings, const dps150_status_t *status, uint64_t fields,
+                      uint64_t now_us);
+
+/**
+ * Append a gap to every channel
+ * @param rings one ring per channel, indexed by telemetry_ch_t
+ * @param now_us monotonic time of the gap
+ */
+void telemetry_mark_gap(telemetry_ring_t *rings, uint64_t now_us);
+
+/**********************
+ *      MACROS
+ **********************/
+
+/* Number of bucket words of one pyramid level */
+#define TELEMETRY_LEVEL_WORDS(capacity, level) \
+    (((capacity) >> (((level) + 1) * TELEMETRY_FANOUT_SHIFT)) * \
+     (sizeof(telemetry_bucket_t) / sizeof(uint64_t)))
+
+/* 64-bit words of storage for a ring of the given capacity */
+#define TELEMETRY_STORAGE_WORDS(capacity) \
+    ((capacity) + TELEMETRY_WINDOW_MAX / 2 + \
+     TELEMETRY_LEVEL_WORDS(capacity, 0) + TELEMETRY_LEVEL_WORDS(capacity, 1) + \
+     TELEMETRY_LEVEL_WORDS(capacity, 2) + TELEMETRY_LEVEL_WORDS(capacity, 3) + \
+     TELEMETRY_LEVEL_WORDS(capacity, 4))
+
+/* Oldest sample still kept */
+#define telemetry_ring_oldest(ring) \
+    ((ring)->count > (uint64_t)(ring)->mask + 1 ? (ring)->count - (ring)->mask - 1 : 0)
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*TELEMETRY_H*/
@@ -0,0 +1,501 @@
+/**
+ * @file dps150_emu.c
+ *
+ * DPS150 emulator
+ *
+ * Creates a pseudo-terminal and answers the DPS150 protocol on it, so
+ * the interface can be run, benchmarked and soak-tested without the
+ * power supply. The output is driven by a resistive load model with
+ * optional noise, faults can be injected on the replies: corrupted
+ * checksums, frames split in two writes and stalls.
+ *
+ * Point the interface at the printed pty path, or at the symlink
+ * given with -l.
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#define _GNU_SOURCE
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdbool.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <poll.h>
+#include <signal.h>
+#include <termios.h>
+#include <time.h>
+
+#include "../lib/simulator_util.h"
+#include "../dps150/dps150_proto.h"
+#include "../dps150/dps150_parser.h"
+#include "../dps150/dps150_encode.h"
+#include "../dps150/dps150_regs.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/* Period of the load model */
+#define EMU_TICK_MS 10
+
+#define EMU_INPUT_V 20.0f
+#define EMU_AMBIENT_C 25.0f
+
+/* Thermal model: degrees per watt at equilibrium, time constant */
+#define EMU_THERMAL_C_PER_W 0.8f
+#define EMU_THERMAL_TAU_S 30.0f
+
+/* Delay between the two halves of a split frame */
+#define EMU_SPLIT_DELAY_US 2000
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+typedef struct {
+    float load_ohm;             /* Resistive load on the output */
+    float noise;                /* Relative noise amplitude of the measurements */
+    float corrupt_rate;         /* Probability of a corrupted checksum per reply */
+    float split_rate;           /* Probability of a reply split in two writes */
+    float stall_rate;           /* Probability of a stall per request */
+    uint32_t stall_ms;          /* Stall duration, requests are not answered */
+    const char *link;           /* Symlink to the pty, NULL for none */
+    bool verbose;
+} emu_settings_t;
+
+typedef struct {
+    uint32_t requests;
+    uint32_t replies;
+    uint32_t sets;
+    uint32_t corrupted;
+    uint32_t split;
+    uint32_t stalls;
+    uint32_t ignored;           /* Requests received while stalled */
+} emu_stats_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void print_usage(void);
+static void configure(int argc, char **argv);
+static void device_init(void);
+static void device_tick(float dt);
+static void frame_cb(uint8_t cmd, uint8_t type, const uint8_t *payload, uint8_t len,
+                     void *user_data);
+static void send_reply(uint8_t type);
+static void write_all(const uint8_t *data, size_t len);
+static float noisy(float value);
+static bool chance(float rate);
+static void on_signal(int sig);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+static emu_settings_t settings = {
+    .load_ohm = 10.0f,
+    .stall_ms = 400,
+};
+
+static emu_stats_t stats;
+static dps150_status_t device;
+static dps150_parser_t parser;
+static int master_fd = -1;
+static uint64_t stall_until_us;
+static volatile sig_atomic_t stop;
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+int main(int argc, char **argv)
+{
+    struct termios tio;
+    struct pollfd pfd;
+    uint8_t buf[512];
+    uint64_t now;
+    uint64_t last_tick;
+    ssize_t n;
+    int slave_fd;
+    const char *slave_name;
+
+    configure(argc, argv);
+    srand((unsigned int)time(NULL));
+
+    master_fd = posix_openpt(O_RDWR | O_NOCTTY | O_CLOEXEC);
+    if (master_fd < 0 || grantpt(master_fd) < 0 || unlockpt(master_fd) < 0) {
+        die("Failed to create the pseudo-terminal: %s\n", strerror(errno));
+    }
+
+    slave_name = ptsname(master_fd);
+
+    /* Hold the slave open so the master does not see a hangup between clients */
+    slave_fd = open(slave_name, O_RDWR | O_NOCTTY | O_CLOEXEC);
+    if (slave_fd < 0) {
+        die("Failed to open %s: %s\n", slave_name, strerror(errno));
+    }
+
+    tcgetattr(slave_fd, &tio);
+    cfmakeraw(&tio);
+    tcsetattr(slave_fd, TCSANOW, &tio);
+
+    if (settings.link != NULL) {
+        unlink(settings.link);
+        if (symlink(slave_name, settings.link) < 0) {
+            die("Failed to link %s: %s\n", settings.link, strerror(errno));
+        }
+    }
+
+    signal(SIGINT, on_signal);
+    signal(SIGTERM, on_signal);
+
+    device_init();
+    dps150_parser_init(&parser, HEADER_OUTPUT, frame_cb, NULL);
+
+    fprintf(stdout, "DPS150 emulator on %s%s%s, %.1f ohm load\n", slave_name,
+            settings.link ? " -> " : "", settings.link ? settings.link : "", settings.load_ohm);
+
+    pfd.fd = master_fd;
+    pfd.events = POLLIN;
+    last_tick = get_monotonic_us();
+
+    while (!stop) {
+        if (poll(&pfd, 1, EMU_TICK_MS) < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            die("poll: %s\n", strerror(errno));
+        }
+
+        now = get_monotonic_us();
+        if (now - last_tick >= EMU_TICK_MS * 1000u) {
+            device_tick((float)(now - last_tick) / 1e6f);
+            last_tick = now;
+        }
+
+        if (pfd.revents & POLLIN) {
+            n = read(master_fd, buf, sizeof(buf));
+            if (n > 0) {
+                dps150_parser_feed(&parser, buf, (size_t)n);
+            }
+        }
+    }
+
+    fprintf(stdout, "\n%u requests, %u replies, %u settings, %u corrupted, %u split, "
+            "%u stalls (%u requests ignored), %u checksum errors\n",
+            stats.requests, stats.replies, stats.sets, stats.corrupted, stats.split,
+            stats.stalls, stats.ignored, parser.checksum_errors);
+
+    if (settings.link != NULL) {
+        unlink(settings.link);
+    }
+    close(slave_fd);
+    close(master_fd);
+
+    return 0;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static void print_usage(void)
+{
+    fprintf(stdout, "\ndps150_emu [-l link] [-r load_ohm] [-n noise] [-c corrupt_rate]"
+                    " [-s split_rate] [-t stall_rate] [-d stall_ms] [-v]\n\n");
+    fprintf(stdout, "-l create a symlink to the pty\n");
+    fprintf(stdout, "-r resistive load on the output in ohm (default 10)\n");
+    fprintf(stdout, "-n relative noise of the measurements, e.g. 0.002\n");
+    fprintf(stdout, "-c probability of a corrupted checksum per reply\n");
+    fprintf(stdout, "-s probability of a reply written in two parts\n");
+    fprintf(stdout, "-t probability of a stall per request\n");
+    fprintf(stdout, "-d stall duration in ms (default 400)\n");
+    fprintf(stdout, "-v print every request\n");
+}
+
+/**
+ * Process the command line arguments
+ * @param argc the count of arguments in argv
+ * @param argv the arguments
+ */
+static void configure(int argc, char **argv)
+{
+    int opt;
+
+    while ((opt = getopt(argc, argv, "l:r:n:c:s:t:d:vh")) != -1) {
+        switch (opt) {
+        case 'h':
+            print_usage();
+            exit(EXIT_SUCCESS);
+            break;
+        case 'l':
+            settings.link = optarg;
+            break;
+        case 'r':
+            settings.load_ohm = strtof(optarg, NULL);
+            if (settings.load_ohm <= 0.0f) {
+                die("The load must be positive\n");
+            }
+            break;
+        case 'n':
+            settings.noise = strtof(optarg, NULL);
+            break;
+        case 'c':
+            settings.corrupt_rate = strtof(optarg, NULL);
+            break;
+        case 's':
+            settings.split_rate = strtof(optarg, NULL);
+            break;
+        case 't':
+            settings.stall_rate = strtof(optarg, NULL);
+            break;
+        case 'd':
+            settings.stall_ms = (uint32_t)atoi(optarg);
+            break;
+        case 'v':
+            settings.verbose = true;
+            break;
+        case ':':
+            print_usage();
+            die("Option -%c requires an argument.\n", optopt);
+            break;
+        case '?':
+            print_usage();
+            die("Unknown option -%c.\n", optopt);
+        }
+    }
+}
+
+/**
+ * Power-on state of the device
+ */
+static void device_init(void)
+{
+    uint32_t i;
+
+    memset(&device, 0, sizeof(device));
+
+    device.input_voltage = EMU_INPUT_V;
+    device.set_voltage = 5.0f;
+    device.set_current = 1.0f;
+    device.temperature = EMU_AMBIENT_C;
+
+    for (i = 0; i < DPS150_GROUP_CNT; i++) {
+        device.group[i].voltage = 3.3f + 1.7f * (float)i;
+        device.group[i].current = 1.0f;
+    }
+
+    device.ovp = 31.0f;
+    device.ocp = 5.2f;
+    device.opp = 150.0f;
+    device.otp = 80.0f;
+    device.lvp = 4.5f;
+    device.brightness = 10;
+    device.volume = 5;
+    device.mode = 1;
+    device.limit_voltage = 30.0f;
+    device.limit_current = 5.1f;
+
+    strcpy(device.model, "DPS-150");
+    strcpy(device.hw_version, "V1.0");
+    strcpy(device.fw_version, "V1.0-emu");
+}
+
+/**
+ * Advance the load and thermal model
+ * @param dt elapsed time in seconds
+ */
+static void device_tick(float dt)
+{
+    float voltage = 0.0f;
+    float current = 0.0f;
+    float target;
+
+    if (device.output) {
+        /* Constant voltage until the load draws more than the current setpoint */
+        voltage = device.set_voltage;
+        current = voltage / settings.load_ohm;
+        device.mode = 1;
+
+        if (current > device.set_current) {
+            current = device.set_current;
+            voltage = current * settings.load_ohm;
+            device.mode = 0;
+        }
+
+        if (voltage > device.input_voltage) {
+            voltage = device.input_voltage;
+            current = voltage / settings.load_ohm;
+        }
+    }
+
+    device.out_voltage = noisy(voltage);
+    device.out_current = noisy(current);
+    device.out_power = device.out_voltage * device.out_current;
+    device.input_voltage = noisy(EMU_INPUT_V);
+
+    device.capacity += device.out_current * dt / 3600.0f;
+    device.energy += device.out_power * dt / 3600.0f;
+
+    target = EMU_AMBIENT_C + device.out_power * EMU_THERMAL_C_PER_W;
+    device.temperature += (target - device.temperature) * dt / EMU_THERMAL_TAU_S;
+
+    if (device.output && device.protection == DPS150_PROTECTION_NONE) {
+        if (device.out_voltage > device.ovp) {
+            device.protection = DPS150_PROTECTION_OVP;
+        } else if (device.out_current > device.ocp) {
+            device.protection = DPS150_PROTECTION_OCP;
+        } else if (device.out_power > device.opp) {
+            device.protection = DPS150_PROTECTION_OPP;
+        } else if (device.temperature > device.otp) {
+            device.protection = DPS150_PROTECTION_OTP;
+        }
+
+        if (device.protection != DPS150_PROTECTION_NONE) {
+            device.output = 0;
+        }
+    }
+}
+
+/**
+ * Handle a frame sent by the host
+ *
+ * @param cmd the command byte of the frame
+ * @param type the register type
+ * @param payload the payload
+ * @param len the payload length
+ * @param user_data unused
+ */
+static void frame_cb(uint8_t cmd, uint8_t type, const uint8_t *payload, uint8_t len,
+                     void *user_data)
+{
+    uint64_t now;
+
+    (void)user_data;
+
+    if (settings.verbose) {
+        fprintf(stdout, "cmd 0x%02x type %u len %u\n", cmd, type, len);
+    }
+
+    switch (cmd) {
+    case CMD_GET:
+        stats.requests++;
+
+        now = get_monotonic_us();
+        if (now < stall_until_us) {
+            stats.ignored++;
+            return;
+        }
+
+        if (chance(settings.stall_rate)) {
+            stall_until_us = now + settings.stall_ms * 1000u;
+            stats.stalls++;
+            stats.ignored++;
+            return;
+        }
+
+        send_reply(type);
+        break;
+
+    case CMD_SET:
+        stats.sets++;
+        dps150_regs_decode(&device, type, payload, len);
+
+        /* Turning the output on clears a tripped protection */
+        if (type == DPS150_REG_OUTPUT && device.output) {
+            device.protection = DPS150_PROTECTION_NONE;
+        }
+        break;
+
+    default:
+        /* Session start and unknown commands need no answer */
+        break;
+    }
+}
+
+/**
+ * Answer a CMD_GET, injecting the configured faults
+ * @param type the register type
+ */
+static void send_reply(uint8_t type)
+{
+    uint8_t payload[DPS150_PAYLOAD_MAX];
+    uint8_t frame[DPS150_FRAME_MAX];
+    uint8_t len;
+    size_t frame_len;
+    size_t half;
+
+    len = dps150_regs_encode(&device, type, payload);
+    if (len == 0) {
+        return;
+    }
+
+    frame_len = dps150_encode(frame, sizeof(frame), HEADER_INPUT, CMD_GET, type, payload, len);
+
+    if (chance(settings.corrupt_rate)) {
+        frame[frame_len - 1] ^= 0x5a;
+        stats.corrupted++;
+    }
+
+    if (chance(settings.split_rate)) {
+        half = 1 + (size_t)rand() % (frame_len - 1);
+        write_all(frame, half);
+        usleep(EMU_SPLIT_DELAY_US);
+        write_all(frame + half, frame_len - half);
+        stats.split++;
+    } else {
+        write_all(frame, frame_len);
+    }
+
+    stats.replies++;
+}
+
+static void write_all(const uint8_t *data, size_t len)
+{
+    ssize_t n;
+
+    while (len > 0) {
+        n = write(master_fd, data, len);
+        if (n < 0) {
+            if (errno == EINTR || errno == EAGAIN) {
+                continue;
+            }
+            perror("write");
+            return;
+        }
+        data += n;
+        len -= (size_t)n;
+    }
+}
+
+static float noisy(float value)
+{
+    float r;
+
+    if (settings.noise <= 0.0f) {
+        return value;
+    }
+
+    r = (float)rand() / (float)RAND_MAX * 2.0f - 1.0f;
+    return value * (1.0f + r * settings.noise);
+}
+
+static bool chance(float rate)
+{
+    return rate > 0.0f && (float)rand() < rate * (float)RAND_MAX;
+}
+
+static void on_signal(int sig)
+{
+    (void)sig;
+    stop = 1;
+}
@@ -84,6 +84,9 @@ int backend_init_x11(backend_t *backend);
 /* Input device driver backends */
 int backend_init_evdev(backend_t *backend);
 
+/* The run loop shared by the display backends, see driver_backends.c */
+void driver_backends_event_loop(void);
+
 /**********************
  *      MACROS
  **********************/
@@ -19,6 +19,10 @@
 #include <stdbool.h>
 #include <string.h>
 #include <ctype.h>
+#include <errno.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
 
 #include "../../lv_port_linux/lvgl/lvgl.h"
 
@@ -43,16 +47,32 @@
 #error Unsupported configuration - Please select at least one graphics backend in lv_conf.h
 #endif
 
+/* Watched file descriptors, the timer and the wakeup eventfd included */
+#define FD_WATCH_MAX 16
+
+/* Events handled per epoll_wait call */
+#define EVENT_BATCH 8
+
 /**********************
  *      TYPEDEFS
  **********************/
 
+typedef struct {
+    int fd;                     /* -1 if the slot is free */
+    driver_backends_fd_cb_t cb;
+    void *user_data;
+} fd_watch_t;
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
 
 /* Internal functions */
 static void register_backends(void);
+static int event_loop_init(void);
+static fd_watch_t *add_watch(int fd, driver_backends_fd_cb_t cb, void *user_data);
+static void drain_fd(int fd, void *user_data);
+static void arm_timer(uint32_t idle_time);
 
 /**********************
  *  STATIC VARIABLES
@@ -100,6 +120,12 @@ static backend_t *backends[sizeof(available_backends) / sizeof(available_backend
 /* Set once the user selects a backend - or it is set to the default backend */
 static backend_t *sel_display_backend = NULL;
 
+/* State of the shared run loop */
+static int epoll_fd = -1;
+static int timer_fd = -1;
+static int wake_fd = -1;
+static fd_watch_t watches[FD_WATCH_MAX];
+
 /**********************
  *  GLOBAL VARIABLES
  **********************/
@@ -283,7 +309,229 @@ void driver_backends_run_loop(void)
     }
 }
 
+int driver_backends_watch_fd(int fd, driver_backends_fd_cb_t cb, void *user_data)
+{
+    /* Backends with their own loop, e.g Wayland, would never dispatch it */
+    if (sel_display_backend == NULL ||
+        sel_display_backend->handle->display->run_loop != driver_backends_event_loop) {
+        return -1;
+    }
+
+    if (event_loop_init() != 0) {
+        return -1;
+    }
+
+    return add_watch(fd, cb, user_data) != NULL ? 0 : -1;
+}
+
+void driver_backends_unwatch_fd(int fd)
+{
+    int i;
+
+    for (i = 0; i < FD_WATCH_MAX; i++) {
+        if (watches[i].fd == fd && watches[i].cb != drain_fd) {
+            epoll_ctl(epoll_fd, EPOLL_CTL_DEL, fd, NULL);
+            watches[i].fd = -1;
+            return;
+        }
+    }
+}
+
+void driver_backends_wakeup(void)
+{
+    uint64_t one = 1;
+    int fd = __atomic_load_n(&wake_fd, __ATOMIC_ACQUIRE);
+
+    if (fd >= 0 && write(fd, &one, sizeof(one)) < 0 && errno != EAGAIN) {
+        LV_LOG_WARN("run loop wakeup failed: %s", strerror(errno));
+    }
+}
+
+/**
+ * The run loop shared by the display backends
+ *
+ * @description sleeps in epoll_wait until the next LVGL timer is due,
+ * a watched file descriptor becomes readable or driver_backends_wakeup
+ * is called. When no timer is pending it sleeps until one of the last two
+ */
+void driver_backends_event_loop(void)
+{
+    struct epoll_event events[EVENT_BATCH];
+    fd_watch_t *watch;
+    uint32_t idle_time;
+    int cnt;
+    int i;
+
+    if (event_loop_init() != 0) {
+        LV_LOG_WARN("Falling back to a polling run loop");
+
+        while (true) {
+            idle_time = lv_timer_handler();
+            usleep(idle_time * 1000);
+        }
+    }
+
+    while (true) {
+
+        /* Returns the time to the next timer execution */
+        idle_time = lv_timer_handler();
+
+        if (idle_time != 0) {
+            arm_timer(idle_time);
+        }
+
+        cnt = epoll_wait(epoll_fd, events, EVENT_BATCH, idle_time == 0 ? 0 : -1);
+        if (cnt < 0) {
+            if (errno != EINTR) {
+                LV_LOG_ERROR("epoll_wait failed: %s", strerror(errno));
+                usleep(LV_DEF_REFR_PERIOD * 1000);
+            }
+            continue;
+        }
+
+        for (i = 0; i < cnt; i++) {
+            watch = events[i].data.ptr;
+
+            /* Skip descriptors unwatched by an earlier callback of the batch */
+            if (watch->fd >= 0) {
+                /* lv_timer_handler locks by itself, the callbacks run outside it */
+                lv_lock();
+                watch->cb(watch->fd, watch->user_data);
+                lv_unlock();
+            }
+        }
+    }
+}
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
 
+/**
+ * Create the epoll instance, the LVGL timer and the wakeup eventfd
+ *
+ * @return 0 on success or if already done, -1 on error
+ */
+static int event_loop_init(void)
+{
+    int i;
+    int fd;
+
+    if (epoll_fd >= 0) {
+        return 0;
+    }
+
+    for (i = 0; i < FD_WATCH_MAX; i++) {
+        watches[i].fd = -1;
+    }
+
+    epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    timer_fd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+
+    if (epoll_fd < 0 || timer_fd < 0 || fd < 0 ||
+        add_watch(timer_fd, drain_fd, NULL) == NULL ||
+        add_watch(fd, drain_fd, NULL) == NULL) {
+
+        LV_LOG_ERROR("Failed to create the run loop: %s", strerror(errno));
+
+        if (fd >= 0) {
+            close(fd);
+        }
+        if (timer_fd >= 0) {
+            close(timer_fd);
+            timer_fd = -1;
+        }
+        if (epoll_fd >= 0) {
+            close(epoll_fd);
+            epoll_fd = -1;
+        }
+        return -1;
+    }
+
+    __atomic_store_n(&wake_fd, fd, __ATOMIC_RELEASE);
+
+    return 0;
+}
+
+/**
+ * Add a file descriptor to the epoll instance
+ *
+ * @param fd the file descriptor
+ * @param cb the callback run when it is readable
+ * @param user_data passed to the callback
+ * @return the watch, NULL if the table is full or epoll_ctl failed
+ */
+static fd_watch_t *add_watch(int fd, driver_backends_fd_cb_t cb, void *user_data)
+{
+    struct epoll_event ev;
+    fd_watch_t *watch = NULL;
+    int i;
+
+    for (i = 0; i < FD_WATCH_MAX && watch == NULL; i++) {
+        if (watches[i].fd < 0) {
+            watch = &watches[i];
+        }
+    }
+
+    if (watch == NULL) {
+        LV_LOG_ERROR("Too many watched file descriptors");
+        return NULL;
+    }
+
+    memset(&ev, 0, sizeof(ev));
+    ev.events = EPOLLIN;
+    ev.data.ptr = watch;
+
+    if (epoll_ctl(epoll_fd, EPOLL_CTL_ADD, fd, &ev) != 0) {
+        LV_LOG_ERROR("Failed to watch fd %d: %s", fd, strerror(errno));
+        return NULL;
+    }
+
+    watch->fd = fd;
+    watch->cb = cb;
+    watch->user_data = user_data;
+
+    return watch;
+}
+
+/**
+ * Consume the counter of the timerfd or the wakeup eventfd
+ *
+ * @description both only wake the loop, lv_timer_handler runs next
+ * @param fd the file descriptor
+ * @param user_data unused
+ */
+static void drain_fd(int fd, void *user_data)
+{
+    uint64_t count;
+
+    LV_UNUSED(user_data);
+
+    if (read(fd, &count, sizeof(count)) < 0 && errno != EAGAIN) {
+        LV_LOG_WARN("read fd %d failed: %s", fd, strerror(errno));
+    }
+}
+
+/**
+ * Program the timerfd with the time to the next LVGL timer
+ *
+ * @param idle_time the value returned by lv_timer_handler, in ms
+ */
+static void arm_timer(uint32_t idle_time)
+{
+    struct itimerspec spec;
+
+    memset(&spec, 0, sizeof(spec));
+
+    /* A zero value disarms the timer: sleep until an input or a wakeup */
+    if (idle_time != LV_NO_TIMER_READY) {
+        spec.it_value.tv_sec = idle_time / 1000;
+        spec.it_value.tv_nsec = (long)(idle_time % 1000) * 1000000L;
+    }
+
+    if (timerfd_settime(timer_fd, 0, &spec, NULL) != 0) {
+        LV_LOG_WARN("timerfd_settime failed: %s", strerror(errno));
+    }
+}
+
@@ -35,6 +35,9 @@ extern "C" {
  *      TYPEDEFS
  **********************/
 
+/* Called by the run loop when a watched file descriptor is readable */
+typedef void (*driver_backends_fd_cb_t)(int fd, void *user_data);
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -78,6 +81,34 @@ int driver_backends_print_supported(void);
  */
 void driver_backends_run_loop(void);
 
+/**
+ * @brief Wake the run loop when a file descriptor becomes readable
+ * @description the callback runs on the LVGL thread, between two calls
+ * of lv_timer_handler, with the LVGL lock held. Must be called from the
+ * LVGL thread
+ *
+ * @param fd the file descriptor, it should be non-blocking
+ * @param cb the callback
+ * @param user_data passed to the callback
+ * @return 0 on success, -1 if the selected backend has its own run loop
+ * or the descriptor cannot be watched
+ */
+int driver_backends_watch_fd(int fd, driver_backends_fd_cb_t cb, void *user_data);
+
+/**
+ * @brief Stop watching a file descriptor
+ * @param fd the file descriptor passed to driver_backends_watch_fd
+ */
+void driver_backends_unwatch_fd(int fd);
+
+/**
+ * @brief Make the run loop run lv_timer_handler now
+ * @description may be called from any thread, e.g. after creating a
+ * timer or invalidating an object from another thread between lv_lock
+ * and lv_unlock
+ */
+void driver_backends_wakeup(void);
+
 /**********************
  *      MACROS
  **********************/
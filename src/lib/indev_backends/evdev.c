@@ -20,11 +20,15 @@
 #include <stdbool.h>
 #include <stdlib.h>
 #include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <linux/input.h>
 
 #include "lvgl/lvgl.h"
 #if LV_USE_EVDEV
 #include "lvgl/src/core/lv_global.h"
 #include "../simulator_util.h"
+#include "../driver_backends.h"
 #include "../backends.h"
 
 /*********************
@@ -44,6 +48,8 @@ static void indev_deleted_cb(lv_event_t *e);
 static void discovery_cb(lv_indev_t *indev, lv_evdev_type_t type, void *user_data);
 static void set_mouse_cursor_icon(lv_indev_t *indev, lv_display_t *display);
 static lv_indev_t *init_pointer_evdev(lv_display_t *display);
+static void watch_evdev(lv_indev_t *indev, const char *input_device);
+static void evdev_readable_cb(int fd, void *user_data);
 
 /**********************
  *  STATIC VARIABLES
@@ -74,6 +80,8 @@ int backend_init_evdev(backend_t *backend)
 
     backend->name = backend_name;
     backend->type = BACKEND_INDEV;
+
+    return 0;
 }
 
 
@@ -172,5 +180,60 @@ static lv_indev_t *init_pointer_evdev(lv_display_t *display)
     lv_indev_set_display(indev, display);
 
     set_mouse_cursor_icon(indev, display);
+
+    watch_evdev(indev, input_device);
+
+    return indev;
+}
+
+/*
+ * Read the input device as soon as it reports events
+ *
+ * @description the LVGL driver owns its file descriptor, a second one
+ * opened on the same device receives the same events and wakes the
+ * run loop. The indev then only needs to be polled while it is pressed,
+ * to detect long presses. Without the shared run loop the indev stays
+ * in timer mode
+ * @param indev the input device
+ * @param input_device the path of the device
+ */
+static void watch_evdev(lv_indev_t *indev, const char *input_device)
+{
+    int fd = open(input_device, O_RDONLY | O_NONBLOCK | O_CLOEXEC);
+
+    if (fd < 0) {
+        LV_LOG_WARN("Failed to open %s, the indev is polled", input_device);
+        return;
+    }
+
+    if (driver_backends_watch_fd(fd, evdev_readable_cb, indev) != 0) {
+        close(fd);
+        return;
+    }
+
+    lv_indev_set_mode(indev, LV_INDEV_MODE_EVENT);
+}
+
+/*
+ * Read the input device
+ *
+ * @note called by the run loop when the device has pending events
+ * @param fd the watched file descriptor
+ * @param user_data the input device
+ */
+static void evdev_readable_cb(int fd, void *user_data)
+{
+    lv_indev_t *indev = user_data;
+    struct input_event events[16];
+
+    /* Only used as a wakeup source, the LVGL driver reads the events */
+    while (read(fd, events, sizeof(events)) > 0) {
+    }
+
+    lv_indev_read(indev);
+
+    /* Poll while pressed so that long press and repeat keep working */
+    lv_indev_set_mode(indev, lv_indev_get_state(indev) == LV_INDEV_STATE_PRESSED ?
+                      LV_INDEV_MODE_TIMER : LV_INDEV_MODE_EVENT);
 }
 #endif /*#if LV_USE_EVDEV*/
@@ -17,6 +17,8 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include <stdarg.h>
+#include <stdint.h>
+#include <time.h>
 
 /*********************
  *      DEFINES
@@ -60,6 +62,14 @@ void die(const char *msg, ...)
 
 }
 
+uint64_t get_monotonic_us(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000u + (uint64_t)ts.tv_nsec / 1000u;
+}
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
@@ -20,6 +20,7 @@ extern "C" {
  *      INCLUDES
  *********************/
 #include <stdarg.h>
+#include <stdint.h>
 
 
 /**********************
@@ -42,6 +43,12 @@ const char *getenv_default(const char *name, const char *default_val);
  */
 void die(const char *msg, ...);
 
+/**
+ * @description Read the monotonic clock
+ * @return microseconds elapsed since an arbitrary, fixed starting point
+ */
+uint64_t get_monotonic_us(void);
+
 /*********************
  *      DEFINES
  *********************/
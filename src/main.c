@@ -25,24 +25,17 @@
 #include <string.h>
 #include <ctype.h>
 #include <errno.h>
+#include <signal.h>
+#include <sys/eventfd.h>
 
 #include <fcntl.h>
 #include <termios.h>
 #include <stdint.h>
-#include <dirent.h>
  #include "ui.h"
  #include "../../lv_port_linux/lvgl/lvgl.h"
 
 
 #define DEFAULT_UART_PORT "/dev/tty*"
-#define HEADER_OUTPUT 0xF1
-#define CMD_XXX_193   0xC1  
-#define BUFFER_SIZE 8192
-static size_t buffer_pos = 0;
-#define HEADER_INPUT  0xf0
-
-#define CMD_GET     0xa1
-static char data_buffer[BUFFER_SIZE];
 
 int uart_fd = -1;
 char selected_port[128] = DEFAULT_UART_PORT;
@@ -51,28 +44,86 @@ lv_obj_t *ui_StatusLabel;
 
 bool is_connected = false;
 static bool is_reading = false;
-static bool command_sent = false; 
+static bool verbose_dump = false;            // -v: çözülen alanları stdout'a yaz
+static char extra_port[128];                 // -p: port listesine eklenen port
+static const char *replay_path = NULL;       // -r: oynatılacak kayıt dosyası
+static float replay_speed = 1.0f;            // -s: oynatma hızı, 0 en hızlı
+static bool auto_connect = true;             // -n: açılışta otomatik bağlanma
+static bool measure_styles = false;          // -S: ekranın nesne ve stil kullanımını yaz
+static bool print_startup = false;           // -T: açılış aşamalarının sürelerini yaz
+static uint32_t bench_frames = 0;            // -D: ekranı n kez baştan çizip kare süresini yaz
 
 #include "../lvgl/demos/lv_demos.h"
 
 #include "src/lib/driver_backends.h"
 #include "src/lib/simulator_util.h"
 #include "src/lib/simulator_settings.h"
+#include "src/dps150/dps150_proto.h"
+#include "src/dps150/serial_io.h"
+#include "src/dps150/dps150_encode.h"
+#include "src/dps150/dps150_regs.h"
+#include "src/dps150/dps150_shadow.h"
+#include "src/dps150/port_watch.h"
+#include "src/dps150/dps150_probe.h"
+#include "src/dps150/dps150_idcache.h"
+#include "src/dps150/telemetry.h"
+#include "src/widgets/chart_bind.h"
+#include "src/widgets/strip_chart.h"
+#include "src/widgets/chart_fill.h"
+#include "src/widgets/frame_governor.h"
+#include "src/widgets/readout.h"
+#include "src/widgets/numeric_display.h"
+#include "src/widgets/obj_stats.h"
+#include "src/widgets/startup_prof.h"
+#include "src/widgets/draw_bench.h"
+
+// Kanal başına saklanan örnek: 10 Hz'de yaklaşık 3.6 saat
+#define TELEMETRY_CAPACITY (1u << 17)
+
+static dps150_shadow_t device_shadow;      // Cihazdan son okunan değerler
+static char connected_serial[PORT_WATCH_SERIAL_MAX];   // Bağlı portun USB seri numarası
+static telemetry_ring_t telemetry[_TELEMETRY_CH_CNT];   // Tam çözünürlüklü ölçüm geçmişi
+static uint64_t telemetry_storage[_TELEMETRY_CH_CNT][TELEMETRY_STORAGE_WORDS(TELEMETRY_CAPACITY)];
+static chart_bind_t chart_binds[4];                     // Grafik serileri, geçmişin son penceresini gösterir
+static uint32_t chart_bind_cnt;
+static strip_chart_t strip_charts[3];                   // Grafiklerin kaydırılarak çizilen alanı
+static uint32_t strip_chart_cnt;
+static bool use_lv_chart = false;                       // -C: grafikleri lv_chart çizer
+static chart_fill_t chart_fills[3];                     // -C: serilerin altındaki gradyent alan
+static frame_governor_t ui_governor;                    // Etiket ve grafik güncellemelerinin kare hızı
+static uint32_t ui_fps = 0;                             // -F: saniyedeki kare, 0 varsayılan
+static bool ui_fps_adaptive = false;                    // -A: yük altında kare atla
+static readout_t temperature_readout;                   // Sıcaklık etiketi, 0.1 C
+static readout_t power_readout;                         // Güç etiketi, 0.1 W
+static numeric_display_t temperature_display;          // Etiketlerin yerine önceden çizilmiş rakamlar
+static numeric_display_t power_display;
+static volatile sig_atomic_t quit_requested;            // SIGINT/SIGTERM alındı
+static int quit_fd = -1;                                // Sinyal ana döngüyü bununla uyandırır
 
+/**
+ * @brief Configure simulator
+ * @description process arguments recieved by the program to select
+ * appropriate options
+ * @param argc the count of arguments in argv
+ * @param argv The arguments
+ */
 static void configure_simulator(int argc, char **argv);
 static void print_lvgl_version(void);
 static void print_usage(void);
-static void draw_event_cb(lv_event_t * e);
-static void add_gradient_area(lv_event_t * e);
 static void event_handler(lv_event_t * e);
+void sendCommandRaw(const uint8_t* data, size_t length);
 void sendCommand(uint8_t c1, uint8_t c2, uint8_t c3, uint8_t* c5, size_t c5_len);
 void print_device_data(uint8_t type, uint8_t* data, uint8_t length);
 static lv_timer_t *serial_read_timer = NULL;
+static bool serial_event_watched = false;   // Olaylar ana döngünün epoll'u ile okunuyor
+static void serial_events_start(void);
+static void serial_events_pause(void);
+static bool connect_port(const char *path, int fd);
+static void auto_connect_try(void);
+static void quit_signals_init(void);
 void uart_close();
-float parse_float(uint8_t* bytes);
 void sendCommandFloat(uint8_t c1, uint8_t c2, uint8_t c3, float c5);
 void button_event_handler(lv_event_t * e);
-void clear_serial_buffer();
 
 
 static char *selected_backend;
@@ -93,8 +144,21 @@ static void print_lvgl_version(void)
 
 static void print_usage(void)
 {
-    fprintf(stdout, "\nlvglsim [-V] [-B] [-b backend_name] [-W window_width] [-H window_height]\n\n");
+    fprintf(stdout, "\nlvglsim [-V] [-B] [-b backend_name] [-W window_width] [-H window_height] [-p port] [-P ms] [-c capture] [-r capture [-s speed]] [-n] [-C] [-F fps] [-A] [-S] [-T] [-D frames] [-v]\n\n");
     fprintf(stdout, "-V print LVGL version\n");
+    fprintf(stdout, "-v print every decoded device register\n");
+    fprintf(stdout, "-p serial port to list first, e.g. the pty of dps150_emu\n");
+    fprintf(stdout, "-P poll period of the output measurements in ms, default %d\n", SERIAL_IO_POLL_PERIOD_MS);
+    fprintf(stdout, "-c record the serial traffic to a capture file\n");
+    fprintf(stdout, "-r replay a capture file instead of connecting\n");
+    fprintf(stdout, "-s replay speed, 1 real time (default), 0 as fast as possible\n");
+    fprintf(stdout, "-n do not search for the device and connect at startup\n");
+    fprintf(stdout, "-C draw the charts with lv_chart instead of the scrolling strip charts\n");
+    fprintf(stdout, "-F labels and charts update rate in frames per second, default %d\n", FRAME_GOVERNOR_FPS_DEFAULT);
+    fprintf(stdout, "-A drop update frames while rendering is too slow\n");
+    fprintf(stdout, "-S print the object count, styles and memory of the screen\n");
+    fprintf(stdout, "-T print the time taken by each startup phase\n");
+    fprintf(stdout, "-D redraw the whole screen n times, print the frame time and exit\n");
     fprintf(stdout, "-B list supported backends\n");
 }
 
@@ -103,41 +167,21 @@ static void event_handler(lv_event_t * e)
 {
     lv_event_code_t code = lv_event_get_code(e);
     lv_obj_t * obj = lv_event_get_target_obj(e);
-    uint8_t value = 1; // Gönderilecek veri
 
     if(code == LV_EVENT_VALUE_CHANGED) {
         
         LV_UNUSED(obj);
         LV_LOG_USER("State: %s\n", lv_obj_has_state(obj, LV_STATE_CHECKED) ? "On" : "Off");
         if(lv_obj_has_state(obj, LV_STATE_CHECKED)){
-
-
-            //sendCommandFloat(HEADER_OUTPUT, 0xb1, 193, 3.14f);
-
-            sendCommand(HEADER_OUTPUT, 177, 219, &value, 1);
-
-            
+            sendCommandRaw(dps150_frame_output_on, sizeof(dps150_frame_output_on));
         }
         else{
-            sendCommand(HEADER_OUTPUT, 177, 219, &value, 0);
-
+            sendCommandRaw(dps150_frame_output_off, sizeof(dps150_frame_output_off));
         }
     }
 }
 
 
-/**
- * @brief Configure simulator
- * @description process arguments recieved by the program to select
- * appropriate options
- * @param argc the count of arguments in argv
- * @param argv The arguments
- */
- void clear_serial_buffer() {
-    tcflush(uart_fd, TCIFLUSH); // Gelen veri buffer'ını temizle
-    usleep(10000); // 10ms bekle (cihazın hazır olması için)
-}
-
  void button_event_handler(lv_event_t * e) {
     lv_obj_t * btn = lv_event_get_target(e);
     
@@ -151,10 +195,19 @@ static void event_handler(lv_event_t * e)
 }
 
 
+/**
+ * @brief Configure simulator
+ * @description process arguments recieved by the program to select
+ * appropriate options
+ * @param argc the count of arguments in argv
+ * @param argv The arguments
+ */
 static void configure_simulator(int argc, char **argv)
 {
     int opt = 0;
     char *backend_name;
+    unsigned long period;
+    char *end;
 
     selected_backend = NULL;
     driver_backends_register();
@@ -164,7 +217,7 @@ static void configure_simulator(int argc, char **argv)
     settings.window_height = atoi(getenv("LV_SIM_WINDOW_HEIGHT") ? : "480");
 
     /* Parse the command-line options. */
-    while ((opt = getopt (argc, argv, "b:fmW:H:BVh")) != -1) {
+    while ((opt = getopt (argc, argv, "b:fmW:H:p:P:c:r:s:nCF:ASTD:BVvh")) != -1) {
         switch (opt) {
         case 'h':
             print_usage();
@@ -174,6 +227,52 @@ static void configure_simulator(int argc, char **argv)
             print_lvgl_version();
             exit(EXIT_SUCCESS);
             break;
+        case 'v':
+            verbose_dump = true;
+            break;
+        case 'c':
+            serial_io_set_capture(optarg);
+            break;
+        case 'r':
+            replay_path = optarg;
+            break;
+        case 's':
+            replay_speed = strtof(optarg, NULL);
+            break;
+        case 'n':
+            auto_connect = false;
+            break;
+        case 'C':
+            use_lv_chart = true;
+            break;
+        case 'F':
+            ui_fps = (uint32_t)strtoul(optarg, NULL, 10);
+            break;
+        case 'A':
+            ui_fps_adaptive = true;
+            break;
+        case 'S':
+            measure_styles = true;
+            break;
+        case 'T':
+            print_startup = true;
+            break;
+        case 'D':
+            bench_frames = (uint32_t)strtoul(optarg, NULL, 10);
+            break;
+        case 'p':
+            snprintf(extra_port, sizeof(extra_port), "%s", optarg);
+            snprintf(selected_port, sizeof(selected_port), "%s", optarg);
+            break;
+        case 'P':
+            errno = 0;
+            period = strtoul(optarg, &end, 10);
+            if (errno != 0 || end == optarg || *end != '\0' ||
+                period == 0 || period > SERIAL_IO_POLL_PERIOD_MAX_MS) {
+                die("The poll period must be 1 to %d ms\n", SERIAL_IO_POLL_PERIOD_MAX_MS);
+            }
+            serial_io_set_poll_period((uint32_t)period);
+            break;
         case 'B':
             driver_backends_print_supported();
             exit(EXIT_SUCCESS);
@@ -207,236 +306,292 @@ static void configure_simulator(int argc, char **argv)
 
 
 
-static void serial_read_timer_cb(lv_timer_t * timer) {
-    if (uart_fd < 0 || !is_reading) return;
-   
-    // 1. Tüm verileri sorgulamak için tek komut gönder
-    if (!command_sent) {
-        uint8_t empty_data = 0;
-        // Use our new sendCommand function
-        sendCommand(HEADER_OUTPUT, CMD_GET, 255, &empty_data, 1);
-
-        command_sent = true;
-        return;
+// Grafiğin serisini şerit grafiğe taşı: lv_chart yalnızca zemini ve eksenleri çizer
+static void strip_chart_add(strip_chart_t *sc, lv_obj_t *chart, lv_chart_series_t *ser,
+                            const telemetry_ring_t *ring, lv_opa_t max_opa, int32_t max) {
+    strip_chart_add_series(sc, ring, lv_chart_get_series_color(chart, ser), max_opa, 0, max);
+    lv_chart_hide_series(chart, ser, true);
+}
+
+static void strip_charts_init(void) {
+    lv_obj_t *charts[] = { ui_Chart1, ui_Chart2, ui_Chart3 };
+    lv_chart_series_t *ser;
+
+    for (uint32_t i = 0; i < sizeof(charts) / sizeof(charts[0]); i++) {
+        if (strip_chart_init(&strip_charts[i], charts[i], lv_obj_get_style_bg_color(charts[i], LV_PART_MAIN),
+                             lv_chart_get_point_count(charts[i])) != 0) {
+            printf("Strip chart buffer allocation failed\n");
+            return;
+        }
     }
+    strip_chart_cnt = sizeof(charts) / sizeof(charts[0]);
+
+    // İlk seri daha opak, ikinci daha transparan
+    ser = lv_chart_get_series_next(ui_Chart1, NULL);
+    strip_chart_add(&strip_charts[0], ui_Chart1, ser, &telemetry[TELEMETRY_CH_TEMPERATURE], 180, 100 * TELEMETRY_SCALE);
+    ser = lv_chart_get_series_next(ui_Chart2, NULL);
+    strip_chart_add(&strip_charts[1], ui_Chart2, ser, &telemetry[TELEMETRY_CH_POWER], 180, 100 * TELEMETRY_SCALE);
+    ser = lv_chart_get_series_next(ui_Chart3, NULL);
+    strip_chart_add(&strip_charts[2], ui_Chart3, ser, &telemetry[TELEMETRY_CH_VOLTAGE], 180, 100 * TELEMETRY_SCALE);
+    ser = lv_chart_get_series_next(ui_Chart3, ser);
+    strip_chart_add(&strip_charts[2], ui_Chart3, ser, &telemetry[TELEMETRY_CH_CURRENT], 150, 30 * TELEMETRY_SCALE);
+}
 
-    // 2. Seri porttan veri oku
-    ssize_t bytes_read = read(uart_fd, data_buffer + buffer_pos, BUFFER_SIZE - buffer_pos - 1);
-    if (bytes_read > 0) {
-        buffer_pos += bytes_read;
-        data_buffer[buffer_pos] = '\0';
-
-        // 3. Veriyi işle
-        for (int i = 0; i < buffer_pos - 6; i++) {
-            if ((uint8_t)data_buffer[i] == HEADER_INPUT && (uint8_t)data_buffer[i+1] == CMD_GET) {
-                uint8_t c3 = data_buffer[i+2];
-                uint8_t c4 = data_buffer[i+3];
-
-                if (i + 4 + c4 >= buffer_pos) break; // eksik paket
-
-                uint8_t checksum = c3 + c4;
-                for (int j = 0; j < c4; j++) {
-                    checksum += data_buffer[i+4+j];
-                }
-                checksum %= 0x100;
-
-                if (checksum != (uint8_t)data_buffer[i+4+c4]) {
-                    printf("Checksum hatası: hesaplanan %02x, gelen %02x\n",
-                           checksum, (uint8_t)data_buffer[i+4+c4]);
-                    break;
-                }
-
-                // Geçerli veri bulundu: işle
-                print_device_data(c3, (uint8_t*)(data_buffer + i + 4), c4);
-
-                // Buffer'ı temizle
-                memset(data_buffer, 0, BUFFER_SIZE);
-                buffer_pos = 0;
-                command_sent = false; // Yeni komut gönderimine izin ver
-                break;
-            }
+// Yeni örnekleri grafiklere yansıt
+static void charts_refresh(void) {
+    chart_bind_refresh(chart_binds, chart_bind_cnt);
+    for (uint32_t i = 0; i < strip_chart_cnt; i++) {
+        strip_chart_refresh(&strip_charts[i]);
+    }
+}
+
+// Grafik serilerini doğrudan ölçüm geçmişine bağla, değerler mili birimlerde
+static void charts_bind(void) {
+    lv_chart_series_t *ser;
+
+    lv_chart_set_range(ui_Chart1, LV_CHART_AXIS_PRIMARY_Y, 0, 100 * TELEMETRY_SCALE);
+    ser = lv_chart_get_series_next(ui_Chart1, NULL);
+    chart_bind_init(&chart_binds[chart_bind_cnt++], ui_Chart1, ser, &telemetry[TELEMETRY_CH_TEMPERATURE]);
+
+    lv_chart_set_range(ui_Chart2, LV_CHART_AXIS_PRIMARY_Y, 0, 100 * TELEMETRY_SCALE);
+    ser = lv_chart_get_series_next(ui_Chart2, NULL);
+    chart_bind_init(&chart_binds[chart_bind_cnt++], ui_Chart2, ser, &telemetry[TELEMETRY_CH_POWER]);
+
+    lv_chart_set_range(ui_Chart3, LV_CHART_AXIS_PRIMARY_Y, 0, 100 * TELEMETRY_SCALE);
+    lv_chart_set_range(ui_Chart3, LV_CHART_AXIS_SECONDARY_Y, 0, 30 * TELEMETRY_SCALE);
+    ser = lv_chart_get_series_next(ui_Chart3, NULL);
+    chart_bind_init(&chart_binds[chart_bind_cnt++], ui_Chart3, ser, &telemetry[TELEMETRY_CH_VOLTAGE]);
+    ser = lv_chart_get_series_next(ui_Chart3, ser);
+    chart_bind_init(&chart_binds[chart_bind_cnt++], ui_Chart3, ser, &telemetry[TELEMETRY_CH_CURRENT]);
+}
+
+static void serial_drain_events(void) {
+    serial_io_evt_t *evt;
+
+    if (!is_reading) return;
+
+    // I/O thread'inin çözdüğü paketleri tek seferde işle
+    while ((evt = serial_io_peek()) != NULL) {
+        if (evt->evt == SERIAL_IO_EVT_ERROR) {
+            printf("Seri port okuma hatası: %s\n", strerror(evt->err));
+            serial_io_release();
+
+            serial_io_stop();
+            uart_fd = serial_io_get_fd();
+            uart_close();
+            telemetry_mark_gap(telemetry, get_monotonic_us());
+            frame_governor_request(&ui_governor);
+            is_reading = false;
+            is_connected = false;
+
+            lv_obj_t *label = lv_obj_get_child(ui_Button1, 0);
+            lv_label_set_text(label, "CONNECT");
+            lv_obj_clear_state(ui_Dropdown2, LV_STATE_DISABLED);
+            lv_obj_add_state(ui_Switch1, LV_STATE_DISABLED);
+
+            serial_events_pause();
+            return;
         }
-    } else if (bytes_read < 0 && errno != EAGAIN) {
-        printf("Seri port okuma hatası: %s\n", strerror(errno));
-        uart_close();
-        is_reading = false;
 
-        lv_obj_t *label = lv_obj_get_child(ui_Button1, 0);
-        lv_label_set_text(label, "CONNECT");
+        // Bağlantı koptu: I/O thread'i yeniden bağlanmayı deniyor
+        if (evt->evt == SERIAL_IO_EVT_LINK_DOWN) {
+            printf("Seri port bağlantısı koptu: %s\n", strerror(evt->err));
+            serial_io_release();
+            lv_label_set_text(ui_StatusLabel, "Stat: Reconnecting...");
+            lv_obj_set_style_bg_color(ui_StatusLabel, lv_color_hex(0x1F1F1F), 0); // Gri
+            // Kopukluk süresince grafiklerde boşluk kalır
+            telemetry_mark_gap(telemetry, evt->timestamp_us);
+            continue;
+        }
 
-        if (serial_read_timer != NULL) {
-            lv_timer_pause(serial_read_timer);
+        if (evt->evt == SERIAL_IO_EVT_LINK_UP) {
+            serial_io_release();
+            lv_label_set_text(ui_StatusLabel, "Stat: Success");
+            lv_obj_set_style_bg_color(ui_StatusLabel, lv_color_hex(0x008800), 0); // Yeşil
+            // Cihaz yeniden açılmış olabilir, tüm alanlar tekrar değişmiş sayılır
+            dps150_shadow_reset(&device_shadow);
+            continue;
+        }
+
+        if (evt->evt == SERIAL_IO_EVT_END) {
+            printf("Replay of %s finished\n", replay_path);
+            serial_io_release();
+            serial_io_stop();
+            is_reading = false;
+            serial_events_pause();
+            break;
         }
+
+        print_device_data(evt->type, evt->data, evt->len);
+        // Her örnek, değeri değişmese de geçmişe yazılır
+        telemetry_record(telemetry, &device_shadow.status, dps150_regs_fields_of(evt->type),
+                         evt->timestamp_us);
+        serial_io_release();
+        frame_governor_request(&ui_governor);
+    }
+}
+
+// Kare başına bir kez: etiketler son değeri, grafikler aradaki tüm örnekleri gösterir
+static void ui_frame_cb(void *user_data) {
+    LV_UNUSED(user_data);
+    dps150_shadow_notify(&device_shadow);
+    charts_refresh();
+}
+
+// Ana döngü, olay sayacı okunabilir olduğunda hemen çağırır
+static void serial_event_fd_cb(int fd, void *user_data) {
+    uint64_t count;
+
+    LV_UNUSED(user_data);
+
+    // Önce sayacı sıfırla, sonra kuyruğu boşalt: hiçbir olay kaçmaz
+    if (read(fd, &count, sizeof(count)) < 0 && errno != EAGAIN) {
+        perror("serial event fd");
+    }
+
+    serial_drain_events();
+}
+
+// Olay sayacı izlenemiyorsa (ör. Wayland) her karede bir kez yokla
+static void serial_read_timer_cb(lv_timer_t * timer) {
+    LV_UNUSED(timer);
+    serial_drain_events();
+}
+
+static void serial_events_start(void) {
+    int fd;
+
+    if (serial_event_watched) return;
+
+    if (serial_read_timer != NULL) {
+        lv_timer_resume(serial_read_timer);
+        return;
+    }
+
+    fd = serial_io_get_event_fd();
+    if (fd >= 0 && driver_backends_watch_fd(fd, serial_event_fd_cb, NULL) == 0) {
+        serial_event_watched = true;
+        return;
+    }
+
+    serial_read_timer = lv_timer_create(serial_read_timer_cb, LV_DEF_REFR_PERIOD, NULL);
+}
+
+// Çıkışta I/O thread'ini durdur ve kaydı kapat, tamponda kalan trafik kaybolmaz
+static void serial_io_at_exit(void) {
+    serial_io_stop();
+    serial_io_close_capture();
+}
+
+// Sinyal işleyicide yalnızca bayrak ve eventfd, çıkış ana döngüde yapılır
+static void quit_signal_handler(int sig) {
+    uint64_t one = 1;
+
+    LV_UNUSED(sig);
+    quit_requested = 1;
+    if (quit_fd >= 0 && write(quit_fd, &one, sizeof(one)) < 0) {
+        // Sayaç doluysa çıkış zaten istenmiş
+    }
+}
+
+static void quit_event_fd_cb(int fd, void *user_data) {
+    LV_UNUSED(fd);
+    LV_UNUSED(user_data);
+    exit(EXIT_SUCCESS);
+}
+
+static void quit_timer_cb(lv_timer_t * timer) {
+    LV_UNUSED(timer);
+    if (quit_requested) exit(EXIT_SUCCESS);
+}
+
+static void quit_signals_init(void) {
+    atexit(serial_io_at_exit);
+
+    quit_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (quit_fd < 0 || driver_backends_watch_fd(quit_fd, quit_event_fd_cb, NULL) != 0) {
+        lv_timer_create(quit_timer_cb, 100, NULL);
+    }
+
+    signal(SIGINT, quit_signal_handler);
+    signal(SIGTERM, quit_signal_handler);
+}
+
+static void serial_events_pause(void) {
+    if (serial_read_timer != NULL) {
+        lv_timer_pause(serial_read_timer);
     }
 }
 
 void print_device_data(uint8_t type, uint8_t* data, uint8_t length) {
-    switch (type) {
-        case 192: // Input voltage
-            printf("Input voltage: %.2f V\n", parse_float(data));
-            break;
-        case 195: // Output voltage, current, power
-            printf("Output voltage: %.2f V\n", parse_float(data));
-            printf("Output current: %.2f A\n", parse_float(data + 4));
-            printf("Output power: %.2f W\n", parse_float(data + 8));
-            break;
-        case 196: // Temperature
-           
-            printf("Temperature: %.1f °C\n", parse_float(data));
-      
-           
-            //lv_chart_refresh(ui_Chart1);
-            break;
-        case 219: // Output status
-            printf("Output: %s\n", data[0] ? "ON" : "OFF");
-            break;
-        case 221: // CC/CV mode
-            printf("Mode: %s\n", data[0] ? "CV" : "CC");
-            break;
-        case 222: // Model name
-            {
-                char model[32] = {0};
-                memcpy(model, data, length);
-                printf("Model name: %s\n", model);
-            }
-            break;
-        case 223: // Hardware version
-            {
-                char version[32] = {0};
-                memcpy(version, data, length);
-                printf("Hardware version: %s\n", version);
-            }
-            break;
-        case 224: // Firmware version
-            {
-                char version[32] = {0};
-                memcpy(version, data, length);
-                printf("Firmware version: %s\n", version);
-            }
-            break;
-        case 255: // All data
-            printf("=========== COMPLETE DEVICE STATUS ===========\n");
-            printf("Input voltage: %.2f V\n", parse_float(data));
-            printf("Set voltage: %.2f V\n", parse_float(data + 4));
-            printf("Set current: %.2f A\n", parse_float(data + 8));
-            printf("Output voltage: %.2f V\n", parse_float(data + 12));
-            printf("Output current: %.2f A\n", parse_float(data + 16));
-            printf("Output power: %.2f W\n", parse_float(data + 20));
-            printf("Temperature: %.1f °C\n", parse_float(data + 24));
-            char buff[10];
-            sprintf(buff," %.1f C\n", parse_float(data + 24));
-            lv_label_set_text(ui_Label3,buff);
-            float temp = parse_float(data+ 24);
-            int32_t temp_scaled = (int32_t)(temp);
-            lv_chart_series_t * ser = lv_chart_get_series_next(ui_Chart1, NULL);
-            lv_chart_set_next_value(ui_Chart1, ser,  temp_scaled); // 0.1°C hassasiyet için 10 ile çarp
-            lv_chart_refresh(ui_Chart1);
-            sprintf(buff," %.1f W\n", parse_float(data + 20));
-            lv_label_set_text(ui_Label5,buff);
-            temp = parse_float(data+ 20);
-            temp_scaled = (int32_t)(temp);
-            ser = lv_chart_get_series_next(ui_Chart2, NULL);
-            lv_chart_set_next_value(ui_Chart2, ser,  temp_scaled); // 0.1°C hassasiyet için 10 ile çarp
-            lv_chart_refresh(ui_Chart2);
-
-
-
-
-
-            lv_chart_series_t *ser_V = lv_chart_get_series_next(ui_Chart3, NULL);
-            temp = parse_float(data+ 12);
-            temp_scaled = (int32_t)(temp);
-            lv_chart_set_next_value(ui_Chart3, ser_V,  temp_scaled); // 0.1°C hassasiyet için 10 ile çarp
-            
-            lv_chart_series_t *ser_A = lv_chart_get_series_next(ui_Chart3, ser_V);
-            temp = parse_float(data+ 16);
-            temp_scaled = (int32_t)(temp);
-            lv_chart_set_next_value(ui_Chart3, ser_A,  temp_scaled); // 0.1°C hassasiyet için 10 ile çarp
-
-            lv_chart_refresh(ui_Chart3);
-
-            // Groups 1-6 settings
-            for (int i = 0; i < 6; i++) {
-                printf("Group %d voltage: %.2f V\n", i+1, parse_float(data + 28 + i*8));
-                printf("Group %d current: %.2f A\n", i+1, parse_float(data + 32 + i*8));
-            }
-            
-            // Protection settings
-            printf("OVP: %.2f V\n", parse_float(data + 76));
-            printf("OCP: %.2f A\n", parse_float(data + 80));
-            printf("OPP: %.2f W\n", parse_float(data + 84));
-            printf("OTP: %.2f °C\n", parse_float(data + 88));
-            printf("LVP: %.2f V\n", parse_float(data + 92));
-            
-            // Device settings
-            printf("Brightness: %d\n", data[96]);
-            printf("Volume: %d\n", data[97]);
-            printf("Metering: %s\n", data[98] ? "CLOSED" : "OPEN");
-            
-            // Output stats
-            printf("Output capacity: %.3f Ah\n", parse_float(data + 99));
-            printf("Output energy: %.3f Wh\n", parse_float(data + 103));
-            printf("Output: %s\n", data[107] ? "ON" : "OFF");
-            
-            // Status
-            const char* protection_states[] = {"NONE", "OVP", "OCP", "OPP", "OTP", "LVP", "REP"};
-            int protection = data[108];
-            if (protection >= 0 && protection < 7) {
-                printf("Protection: %s\n", protection_states[protection]);
-            } else {
-                printf("Protection: UNKNOWN (%d)\n", protection);
-            }
-            
-            printf("Mode: %s\n", data[109] ? "CV" : "CC");
-            
-            // Limits
-            printf("Upper limit voltage: %.2f V\n", parse_float(data + 111));
-            printf("Upper limit current: %.2f A\n", parse_float(data + 115));
-            printf("============================================\n");
-            break;
-        default:
-            printf("Unknown data type: %d\n", type);
-            printf("Data: ");
-            for (int i = 0; i < length; i++) {
-                printf("%02x ", data[i]);
-            }
-            printf("\n");
+    if (dps150_regs_fields_of(type) == 0) {
+        printf("Unknown data type: %d\n", type);
+        printf("Data: ");
+        for (int i = 0; i < length; i++) {
+            printf("%02x ", data[i]);
+        }
+        printf("\n");
+        return;
+    }
+
+    // Etiketler yalnızca değer değiştiğinde, abonelikler üzerinden kare başına güncellenir.
+    // Grafikler örnekleri ölçüm geçmişinden okur
+    uint64_t changed = dps150_shadow_update(&device_shadow, type, data, length);
+
+    // -v: kareler atlansa da her örneğin değişen alanları yazılır
+    if (verbose_dump && changed != 0) {
+        dps150_regs_dump(&device_shadow.status, changed, stdout);
     }
 }
-float parse_float(uint8_t* bytes) {
-    float value;
-    memcpy(&value, bytes, 4);
-    return value;
+
+// Sıcaklık etiketi - gösterilen basamaklar değişmezse etikete dokunulmaz
+static void temperature_changed_cb(const dps150_status_t *status, uint64_t changed, void *user_data) {
+    LV_UNUSED(changed);
+    LV_UNUSED(user_data);
+    readout_set(&temperature_readout, telemetry_value_of(status, TELEMETRY_CH_TEMPERATURE));
+}
+
+// Güç etiketi
+static void power_changed_cb(const dps150_status_t *status, uint64_t changed, void *user_data) {
+    LV_UNUSED(changed);
+    LV_UNUSED(user_data);
+    readout_set(&power_readout, telemetry_value_of(status, TELEMETRY_CH_POWER));
+}
+
+// Model adı okununca portun kimliğini önbelleğe yaz, sonraki açılışta arama yapılmaz
+static void model_changed_cb(const dps150_status_t *status, uint64_t changed, void *user_data) {
+    LV_UNUSED(changed);
+    LV_UNUSED(user_data);
+    if (is_connected && status->model[0] != '\0') {
+        dps150_idcache_store(connected_serial, status->model);
+    }
+}
+
+static void device_shadow_init(void) {
+    for (int ch = 0; ch < _TELEMETRY_CH_CNT; ch++) {
+        telemetry_ring_init(&telemetry[ch], telemetry_storage[ch], TELEMETRY_CAPACITY);
+    }
+
+    dps150_shadow_init(&device_shadow);
+    dps150_shadow_subscribe(&device_shadow, DPS150_FIELD_BIT(DPS150_FIELD_MODEL),
+                            model_changed_cb, NULL);
+    dps150_shadow_subscribe(&device_shadow, DPS150_FIELD_BIT(DPS150_FIELD_TEMPERATURE),
+                            temperature_changed_cb, NULL);
+    dps150_shadow_subscribe(&device_shadow, DPS150_FIELD_BIT(DPS150_FIELD_OUT_POWER),
+                            power_changed_cb, NULL);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
 
 int uart_open(const char* portname) {
-    uart_fd = open(portname, O_RDWR | O_NOCTTY | O_NDELAY);
+    // 115200 8N1, raw; otomatik aramayla aynı ayarlar
+    uart_fd = dps150_probe_open(portname);
     if (uart_fd == -1) {
         perror("UART open failed");
         return -1;
     }
 
-    struct termios options;
-    tcgetattr(uart_fd, &options);
-
-    cfsetispeed(&options, B115200);  // Baud rate ayarı
-    cfsetospeed(&options, B115200);
-
-    options.c_cflag |= (CLOCAL | CREAD);    // Receiver açık
-    options.c_cflag &= ~PARENB;              // Parity yok
-    options.c_cflag &= ~CSTOPB;              // 1 stop bit
-    options.c_cflag &= ~CSIZE;
-    options.c_cflag |= CS8;                  // 8 data bits
-    options.c_cflag |= CRTSCTS;
-    options.c_lflag &= ~(ICANON | ECHO | ECHOE | ISIG); // Raw input
-    options.c_iflag &= ~(IXON | IXOFF | IXANY);         // Yazılım akış kontrolü yok
-    options.c_oflag &= ~OPOST;                          // Raw output
-
-    tcsetattr(uart_fd, TCSANOW, &options);
-
     return 0;
 }
 
@@ -448,152 +603,326 @@ void uart_close() {
     }
 }
 
-// UART'a veri gönderen fonksiyon
-void sendCommandRaw(uint8_t* data, size_t length) {
+// UART'a veri gönderen fonksiyon - yazma işlemini I/O thread'i yapar
+void sendCommandRaw(const uint8_t* data, size_t length) {
     if (uart_fd == -1) {
         printf("UART not opened!\n");
         return;
     }
-    clear_serial_buffer();  // Buffer'ı temizle
 
-    ssize_t bytes_written = write(uart_fd, data, length);
-    if (bytes_written < 0) {
-        perror("UART write failed");
-    } else {
-        printf("Sent %zd bytes over UART.\n", bytes_written);
+    if (serial_io_send(data, length) != 0) {
+        printf("UART TX queue full, command dropped!\n");
     }
 }
 
-// Komut oluşturan fonksiyon
+// Komut oluşturan fonksiyon - paket doğrudan TX kuyruğundaki yuvaya yazılır
 void sendCommand(uint8_t c1, uint8_t c2, uint8_t c3, uint8_t* c5, size_t c5_len) {
-    uint8_t c4 = (uint8_t)c5_len;
-    uint8_t c6 = c3 + c4;
+    uint8_t *slot;
+
+    if (uart_fd == -1) {
+        printf("UART not opened!\n");
+        return;
+    }
+
+    slot = serial_io_tx_reserve();
+    if (slot == NULL) {
+        printf("UART TX queue full, command dropped!\n");
+        return;
+    }
 
-    for (size_t i = 0; i < c5_len; i++) {
-        c6 += c5[i];
+    serial_io_tx_commit(dps150_encode(slot, DPS150_FRAME_MAX, c1, c2, c3, c5, (uint8_t)c5_len));
+}
+void sendCommandFloat(uint8_t c1, uint8_t c2, uint8_t c3, float c5) {
+    uint8_t *slot;
+
+    if (uart_fd == -1) {
+        printf("UART not opened!\n");
+        return;
     }
 
-    size_t total_len = c5_len + 5;
-    uint8_t* c = (uint8_t*)malloc(total_len);
-    if (c == NULL) {
-        printf("Memory allocation failed!\n");
+    slot = serial_io_tx_reserve();
+    if (slot == NULL) {
+        printf("UART TX queue full, command dropped!\n");
         return;
     }
 
-    c[0] = c1;
-    c[1] = c2;
-    c[2] = c3;
-    c[3] = c4;
-    memcpy(&c[4], c5, c5_len);
-    c[total_len - 1] = c6;
+    // Float değeri doğrudan yuvaya kodlanır, heap kullanılmaz
+    serial_io_tx_commit(dps150_encode_float(slot, DPS150_FRAME_MAX, c1, c2, c3, c5));
+}
+// Sabitler
 
-    sendCommandRaw(c, total_len);
+// Seri port listesi: -p ile verilen port ilk sırada, ardından izleyicinin
+// bulduğu USB CDC portları. Liste arka planda güncellenir.
+static port_watch_port_t port_list[PORT_WATCH_MAX];
+static int port_cnt = 0;
+static uint32_t port_generation = 0;
+// Her satıra yer var: snprintf hiçbir zaman kesmez
+static char port_options[sizeof(extra_port) + PORT_WATCH_MAX * (PORT_WATCH_NAME_MAX + 16)];
+
+// Dropdown'daki sıraya göre izleyicinin bulduğu port, -p portu için NULL
+static const port_watch_port_t *port_entry_at(uint32_t idx) {
+    if (extra_port[0] != '\0') {
+        if (idx == 0) return NULL;
+        idx--;
+    }
 
-    free(c);
+    return idx < (uint32_t)port_cnt ? &port_list[idx] : NULL;
 }
-void sendCommandFloat(uint8_t c1, uint8_t c2, uint8_t c3, float c5) {
-    // Float değerini 4 byte'lık bir buffer'a kopyala
-    uint8_t buffer[4];
-    memcpy(buffer, &c5, sizeof(float));
-    
-    // sendCommand fonksiyonunu çağır
-    sendCommand(c1, c2, c3, buffer, sizeof(buffer));
+
+// Dropdown'daki sıraya göre portun tam yolu, yoksa false
+static bool port_path_at(uint32_t idx, char *buf, size_t size) {
+    const port_watch_port_t *port = port_entry_at(idx);
+
+    if (port != NULL) {
+        snprintf(buf, size, "/dev/%s", port->name);
+        return true;
+    }
+
+    if (idx == 0 && extra_port[0] != '\0') {
+        snprintf(buf, size, "%s", extra_port);
+        return true;
+    }
+
+    return false;
 }
-// Sabitler
 
-// Linux sisteminde kullanılabilir seri portları tarar
-char* scan_serial_ports() {
-    static char ports_list[1024] = {0};
-    memset(ports_list, 0, sizeof(ports_list));
-
-    // Linux'ta tipik seri port konumları
-    const char* paths[] = {
-        "/dev/ttyUSB", 
-        "/dev/ttyACM", 
-        "/dev/ttyS"
-    };
-
-    int total_count = 0;
-    DIR* dir;
-    struct dirent* ent;
-    char temp[256];
-
-    // /dev dizinini aç
-    if ((dir = opendir("/dev")) != NULL) {
-        // Tüm portları tara
-        while ((ent = readdir(dir)) != NULL) {
-            for (int i = 0; i < sizeof(paths) / sizeof(paths[0]); i++) {
-                if (strncmp(ent->d_name, paths[i] + 5, strlen(paths[i]) - 5) == 0) {
-                    snprintf(temp, sizeof(temp), "%s%s", strlen(ports_list) > 0 ? "\n" : "", ent->d_name);
-                    strcat(ports_list, temp);
-                    total_count++;
-                    break;
-                }
-            }
+// Port listesi değiştiyse dropdown'u yeniden doldur, seçili portu koru
+static void update_port_options(void) {
+    char path[sizeof(selected_port)];
+    size_t len = 0;
+    uint32_t idx;
+    int cnt;
+
+    cnt = port_watch_get_ports(port_list, &port_generation);
+    if (cnt < 0) return;
+    port_cnt = cnt;
+
+    port_options[0] = '\0';
+    if (extra_port[0] != '\0') {
+        len += snprintf(port_options + len, sizeof(port_options) - len, "%s\n", extra_port);
+    }
+    for (int i = 0; i < port_cnt; i++) {
+        len += snprintf(port_options + len, sizeof(port_options) - len, "%s%s\n",
+                        port_list[i].name, port_list[i].dps150 ? " (DPS-150)" : "");
+    }
+    if (len == 0) {
+        snprintf(port_options, sizeof(port_options), "No port\n");
+    }
+    port_options[strlen(port_options) - 1] = '\0';   // Son satır sonunu sil
+
+    lv_dropdown_set_options(ui_Dropdown2, port_options);
+
+    for (idx = 0; port_path_at(idx, path, sizeof(path)); idx++) {
+        if (strcmp(path, selected_port) == 0) {
+            lv_dropdown_set_selected(ui_Dropdown2, idx);
+            break;
         }
-        closedir(dir);
     }
 
-    // Eğer hiç port bulunamadıysa, varsayılan değeri kullan
-    if (total_count == 0) {
-        strcpy(ports_list, "ttyACM0\nttyUSB0");
+    // Seçili port çıkarıldı: bağlı değilsek ilk porta geç
+    if (!port_path_at(idx, path, sizeof(path)) && !is_connected &&
+        port_path_at(0, path, sizeof(path))) {
+        snprintf(selected_port, sizeof(selected_port), "%s", path);
+        printf("Selected UART port: %s\n", selected_port);
     }
 
-    return ports_list;
+    auto_connect_try();
+}
+
+static void port_event_fd_cb(int fd, void *user_data) {
+    uint64_t count;
+
+    LV_UNUSED(user_data);
+
+    if (read(fd, &count, sizeof(count)) < 0 && errno != EAGAIN) {
+        perror("port event fd");
+    }
+
+    update_port_options();
+}
+
+static void port_timer_cb(lv_timer_t * timer) {
+    LV_UNUSED(timer);
+    update_port_options();
+}
+
+// Otomatik arama bitti: cevap veren ilk porta açık haliyle bağlan
+static void probe_done(void) {
+    dps150_probe_result_t res;
+
+    // İptal edilmiş bir aramadan kalan olay
+    if (!dps150_probe_running()) return;
+
+    if (dps150_probe_finish(&res) != 0) {
+        printf("No DPS150 answered\n");
+        lv_label_set_text(ui_StatusLabel, "Stat: No device");
+        return;
+    }
+
+    printf("%s answered on %s in %u ms\n", res.model, res.path, res.elapsed_ms);
+    if (is_connected || !connect_port(res.path, res.fd)) {
+        close(res.fd);
+        return;
+    }
+    auto_connect = false;
+}
+
+static void probe_event_fd_cb(int fd, void *user_data) {
+    uint64_t count;
+
+    LV_UNUSED(user_data);
+
+    if (read(fd, &count, sizeof(count)) == sizeof(count)) {
+        probe_done();
+    }
+}
+
+static void probe_timer_cb(lv_timer_t * timer) {
+    LV_UNUSED(timer);
+    probe_event_fd_cb(dps150_probe_get_event_fd(), NULL);
+}
+
+// Port izleyicisini başlat, değişiklikler ana döngüyü uyandırır
+static void port_list_init(void) {
+    if (port_watch_start() != 0) {
+        printf("Failed to start the serial port watcher\n");
+        return;
+    }
+
+    if (driver_backends_watch_fd(port_watch_get_event_fd(), port_event_fd_cb, NULL) != 0) {
+        lv_timer_create(port_timer_cb, 500, NULL);
+    }
+
+    if (auto_connect && replay_path == NULL) {
+        dps150_idcache_load(NULL);
+        if (driver_backends_watch_fd(dps150_probe_get_event_fd(), probe_event_fd_cb, NULL) != 0) {
+            lv_timer_create(probe_timer_cb, 50, NULL);
+        }
+    }
 }
 
 static void dropdown_event_cb(lv_event_t * e) {
     lv_obj_t * obj = lv_event_get_target(e);
-    int selected_idx = lv_dropdown_get_selected(obj);
-    char buf[128];
-    
-    lv_dropdown_get_selected_str(obj, buf, sizeof(buf));
-    snprintf(selected_port, sizeof(selected_port), "/dev/%s", buf);
+    uint32_t selected_idx = lv_dropdown_get_selected(obj);
+
+    if (!port_path_at(selected_idx, selected_port, sizeof(selected_port))) return;
     printf("Selected UART port: %s\n", selected_port);
 }
 
+// Porta bağlan: fd >= 0 ise otomatik aramanın açık bıraktığı port kullanılır
+static bool connect_port(const char *path, int fd) {
+    lv_obj_t *label = lv_obj_get_child(ui_Button1, 0);  // Buton içindeki etiketi al
+    char buf[sizeof(selected_port)];
+
+    if (path != selected_port) {
+        snprintf(selected_port, sizeof(selected_port), "%s", path);
+    }
+
+    if (fd >= 0) {
+        uart_fd = fd;
+    } else if (uart_open(selected_port) != 0) {
+        lv_label_set_text(ui_StatusLabel, "Stat: Connection Error!");
+        lv_obj_set_style_bg_color(ui_StatusLabel, lv_color_hex(0x1F1F1F), 0); // Kırmızı
+        printf("Failed to connect to %s\n", selected_port);
+        return false;
+    }
+
+    is_connected = true;
+    is_reading= true;
+
+    lv_label_set_text(ui_StatusLabel, "Stat: Success");
+    lv_obj_set_style_bg_color(ui_StatusLabel, lv_color_hex(0x008800), 0); // Yeşil
+    // Yeni bağlantıda tüm alanlar tekrar değişmiş sayılır
+    dps150_shadow_reset(&device_shadow);
+    serial_events_start();
+
+    // Dropdown'da bağlanılan portu göster, kimlik önbelleği için seri numarasını sakla
+    connected_serial[0] = '\0';
+    for (uint32_t idx = 0; port_path_at(idx, buf, sizeof(buf)); idx++) {
+        if (strcmp(buf, selected_port) == 0) {
+            lv_dropdown_set_selected(ui_Dropdown2, idx);
+            if (port_entry_at(idx) != NULL) {
+                snprintf(connected_serial, sizeof(connected_serial), "%s", port_entry_at(idx)->serial);
+            }
+            break;
+        }
+    }
+
+    // Port koparsa I/O thread'i aynı cihazı seri numarasıyla yeniden açar
+    serial_io_set_reconnect(selected_port, connected_serial);
+    if (serial_io_start(uart_fd) != 0) {
+        printf("Failed to start serial I/O thread\n");
+    }
+
+    // Buton etiketini doğru şekilde güncelle
+    if (label != NULL && lv_obj_check_type(label, &lv_label_class)) {
+        lv_obj_set_style_text_color(label,lv_color_hex(0x008800), 0);
+        lv_label_set_text(label, "Disconnect");
+    }
+    
+    // Dropdown'u devre dışı bırak
+    lv_obj_add_state(ui_Dropdown2, LV_STATE_DISABLED);
+    lv_obj_clear_state(ui_Switch1, LV_STATE_DISABLED);
+
+    printf("Connected to %s successfully\n", selected_port);
+
+    return true;
+}
+
+// Açılışta DPS150'yi bul: önbellekte seri numarası olan porta doğrudan,
+// yoksa bütün portları aynı anda sorgulayarak bağlan
+static void auto_connect_try(void) {
+    char paths[DPS150_PROBE_MAX][sizeof(selected_port)];
+    const char *path_ptrs[DPS150_PROBE_MAX];
+    const char *model;
+    uint32_t cnt;
+
+    if (!auto_connect || is_connected || replay_path != NULL) return;
+
+    for (int i = 0; i < port_cnt; i++) {
+        model = dps150_idcache_lookup(port_list[i].serial);
+        if (model != NULL) {
+            printf("Known %s on /dev/%s\n", model, port_list[i].name);
+            snprintf(paths[0], sizeof(paths[0]), "/dev/%s", port_list[i].name);
+            dps150_probe_cancel();
+            if (connect_port(paths[0], -1)) {
+                auto_connect = false;
+                return;
+            }
+        }
+    }
+
+    // Liste değişti: arama yeni listeyle baştan başlar
+    dps150_probe_cancel();
+
+    for (cnt = 0; cnt < DPS150_PROBE_MAX && port_path_at(cnt, paths[cnt], sizeof(paths[cnt])); cnt++) {
+        path_ptrs[cnt] = paths[cnt];
+    }
+    if (cnt == 0) return;
+
+    if (dps150_probe_start(path_ptrs, cnt, DPS150_PROBE_TIMEOUT_MS) == 0) {
+        lv_label_set_text(ui_StatusLabel, "Stat: Searching...");
+    }
+}
+
 static void connect_btn_event_cb(lv_event_t * e) {
     lv_obj_t *btn = lv_event_get_target(e);
     lv_obj_t *label = lv_obj_get_child(btn, 0);  // Buton içindeki etiketi al
     
     if (!is_connected) {
-        // Bağlan
-        if (uart_open(selected_port) == 0) {
-            is_connected = true;
-            is_reading= true;
-
-            lv_label_set_text(ui_StatusLabel, "Stat: Success");
-            lv_obj_set_style_bg_color(ui_StatusLabel, lv_color_hex(0x008800), 0); // Yeşil
-            if (serial_read_timer == NULL) {
-                serial_read_timer = lv_timer_create(serial_read_timer_cb, 100, NULL);  // 100ms interval
-                uint8_t value = 1; // Gönderilecek veri
-    
-                // Komut gönder
-                sendCommand(HEADER_OUTPUT, CMD_XXX_193, 0, &value, 1);
-                printf("Command sent\n");
-            } else {
-                lv_timer_resume(serial_read_timer);
-            }
-            // Buton etiketini doğru şekilde güncelle
-            if (label != NULL && lv_obj_check_type(label, &lv_label_class)) {
-                lv_obj_set_style_text_color(label,lv_color_hex(0x008800), 0);
-                lv_label_set_text(label, "Disconnect");
-            }
-            
-            // Dropdown'u devre dışı bırak
-            lv_obj_add_state(ui_Dropdown2, LV_STATE_DISABLED);
-            lv_obj_clear_state(ui_Switch1, LV_STATE_DISABLED);
-
-            printf("Connected to %s successfully\n", selected_port);
-        } else {
-            lv_label_set_text(ui_StatusLabel, "Stat: Connection Error!");
-            lv_obj_set_style_bg_color(ui_StatusLabel, lv_color_hex(0x1F1F1F), 0); // Kırmızı
-            printf("Failed to connect to %s\n", selected_port);
-        }
+        // Bağlan - elle bağlanınca otomatik arama durur
+        auto_connect = false;
+        dps150_probe_cancel();
+        connect_port(selected_port, -1);
     } else {
-        // Bağlantıyı kes
+        // Bağlantıyı kes - yeniden bağlanmış olabilir, güncel fd'yi kapat
+        serial_io_stop();
+        uart_fd = serial_io_get_fd();
         uart_close();
+        telemetry_mark_gap(telemetry, get_monotonic_us());
+        frame_governor_request(&ui_governor);
         is_connected = false;
+        is_reading = false;
         lv_label_set_text(ui_StatusLabel, "Stat: Connection  Lost");
         lv_obj_set_style_bg_color(ui_StatusLabel, lv_color_hex(0x1F1F1F), 0); // Gri
         
@@ -634,102 +963,14 @@ static void send_cmd_event_cb(lv_event_t * e) {
 
 
 void lv_example_chart_gradient(void)
- {
- 
-     /*Gradyent efekt için olay işleyici ekleme*/
-     lv_obj_add_event_cb(ui_Chart1, draw_event_cb, LV_EVENT_DRAW_TASK_ADDED, NULL);
-     lv_obj_add_flag(ui_Chart1, LV_OBJ_FLAG_SEND_DRAW_TASK_EVENTS);
-     lv_obj_add_event_cb(ui_Chart2, draw_event_cb, LV_EVENT_DRAW_TASK_ADDED, NULL);
-     lv_obj_add_flag(ui_Chart2, LV_OBJ_FLAG_SEND_DRAW_TASK_EVENTS);
-     lv_obj_add_event_cb(ui_Chart3, draw_event_cb, LV_EVENT_DRAW_TASK_ADDED, NULL);
-     lv_obj_add_flag(ui_Chart3, LV_OBJ_FLAG_SEND_DRAW_TASK_EVENTS);
- 
- }
- static void add_gradient_area(lv_event_t * e)
- {
-     lv_obj_t * obj = lv_event_get_target_obj(e);
-     lv_area_t coords;
-     lv_obj_get_coords(obj, &coords);
- 
-     lv_draw_task_t * draw_task = lv_event_get_draw_task(e);
-     lv_draw_dsc_base_t * base_dsc = (lv_draw_dsc_base_t *)lv_draw_task_get_draw_dsc(draw_task);
- 
-     /*Çizilen seriyi al*/
-     const lv_chart_series_t * ser = lv_chart_get_series_next(obj, NULL);
-     int series_index = 0;
-     
-     /*Doğru seriyi bulmak için serileri döngüyle kontrol et*/
-     while(ser != NULL) {
-         if(base_dsc->id1 == series_index) {
-             break; /*Doğru seriyi bulduk*/
-         }
-         ser = lv_chart_get_series_next(obj, ser);
-         series_index++;
-     }
-     
-     /*Eğer seri bulunamadıysa çık*/
-     if(ser == NULL) return ;
- 
-     
-     lv_color_t ser_color = lv_chart_get_series_color(obj, ser);
- 
-     /*Çizginin altına gradyent üçgen ekleme*/
-     lv_draw_line_dsc_t * draw_line_dsc = (lv_draw_line_dsc_t *)lv_draw_task_get_draw_dsc(draw_task);
-     lv_draw_triangle_dsc_t tri_dsc;
- 
-     lv_draw_triangle_dsc_init(&tri_dsc);
-     tri_dsc.p[0].x = draw_line_dsc->p1.x;
-     tri_dsc.p[0].y = draw_line_dsc->p1.y;
-     tri_dsc.p[1].x = draw_line_dsc->p2.x;
-     tri_dsc.p[1].y = draw_line_dsc->p2.y;
-     tri_dsc.p[2].x = draw_line_dsc->p1.y < draw_line_dsc->p2.y ? draw_line_dsc->p1.x : draw_line_dsc->p2.x;
-     tri_dsc.p[2].y = LV_MAX(draw_line_dsc->p1.y, draw_line_dsc->p2.y);
-     tri_dsc.grad.dir = LV_GRAD_DIR_VER;
- 
-     int32_t full_h = lv_obj_get_height(obj);
-     int32_t fract_upper = (int32_t)(LV_MIN(draw_line_dsc->p1.y, draw_line_dsc->p2.y) - coords.y1) * 255 / full_h;
-     int32_t fract_lower = (int32_t)(LV_MAX(draw_line_dsc->p1.y, draw_line_dsc->p2.y) - coords.y1) * 255 / full_h;
-     
-     /*Opaklığı ayarla - her seri için daha düşük değer kullan, böylece üst üste binince görünür kalır*/
-     lv_opa_t max_opa = series_index == 0 ? 180 : 150; /*İlk seri daha opak, ikinci daha transparan*/
-     
-     tri_dsc.grad.stops[0].color = ser_color;
-     tri_dsc.grad.stops[0].opa = (max_opa * (255 - fract_upper)) / 255;
-     tri_dsc.grad.stops[0].frac = 0;
-     tri_dsc.grad.stops[1].color = ser_color;
-     tri_dsc.grad.stops[1].opa = (max_opa * (255 - fract_lower)) / 255;
-     tri_dsc.grad.stops[1].frac = 255;
- 
-     lv_draw_triangle(base_dsc->layer, &tri_dsc);
- 
-     /*Üçgenin altına gradyent dikdörtgen ekleme*/
-     lv_draw_rect_dsc_t rect_dsc;
-     lv_draw_rect_dsc_init(&rect_dsc);
-     rect_dsc.bg_grad.dir = LV_GRAD_DIR_VER;
-     rect_dsc.bg_grad.stops[0].color = ser_color;
-     rect_dsc.bg_grad.stops[0].frac = 0;
-     rect_dsc.bg_grad.stops[0].opa = (max_opa * (255 - fract_lower)) / 255;
-     rect_dsc.bg_grad.stops[1].color = ser_color;
-     rect_dsc.bg_grad.stops[1].frac = 255;
-     rect_dsc.bg_grad.stops[1].opa = 0;
- 
-     lv_area_t rect_area;
-     rect_area.x1 = (int32_t)draw_line_dsc->p1.x;
-     rect_area.x2 = (int32_t)draw_line_dsc->p2.x - 1;
-     rect_area.y1 = (int32_t)LV_MAX(draw_line_dsc->p1.y, draw_line_dsc->p2.y) - 1;
-     rect_area.y2 = (int32_t)coords.y2;
-     lv_draw_rect(base_dsc->layer, &rect_dsc, &rect_area);
- }
- static void draw_event_cb(lv_event_t * e)
- {
-     lv_draw_task_t * draw_task = lv_event_get_draw_task(e);
-     lv_draw_dsc_base_t * base_dsc = (lv_draw_dsc_base_t *)lv_draw_task_get_draw_dsc(draw_task);
- 
-     /*Sadece çizgilerin çizimi sırasında gradyent ekle*/
-     if(base_dsc->part == LV_PART_ITEMS && lv_draw_task_get_type(draw_task) == LV_DRAW_TASK_TYPE_LINE) {
-         add_gradient_area(e);
-     }
- }
+{
+    // Seri başına tek resim: çizginin altı tek geçişte doldurulur, seri değişmedikçe yeniden çizilmez
+    static const lv_opa_t max_opa[] = { 180, 150 };   // İlk seri daha opak, ikinci daha transparan
+
+    chart_fill_attach(&chart_fills[0], ui_Chart1, max_opa);
+    chart_fill_attach(&chart_fills[1], ui_Chart2, max_opa);
+    chart_fill_attach(&chart_fills[2], ui_Chart3, max_opa);
+}
 // UI oluşturma fonksiyonu
 void create_ui() {
 
@@ -737,8 +978,9 @@ void create_ui() {
     lv_label_set_text(ui_PortLabel, "Seri Port:");
     lv_obj_align(ui_PortLabel, LV_ALIGN_TOP_LEFT, 40, 70);
     
-    // Dropdown menü
-    lv_dropdown_set_options(ui_Dropdown2, scan_serial_ports());
+    // Dropdown menü, portlar ilk kareden sonra izlenmeye başlar
+    lv_dropdown_set_options(ui_Dropdown2, extra_port[0] != '\0' ? extra_port : "No port");
+    startup_prof_defer("port_list_init", port_list_init);
     lv_obj_add_event_cb(ui_Dropdown2, dropdown_event_cb, LV_EVENT_VALUE_CHANGED, NULL);
     
     // Bağlan butonu
@@ -849,12 +1091,37 @@ void lv_example_list_1(void)
     lv_obj_set_y(labelLine2,25);
 
 }
+// Kare süresi ölçümü bitti: sonucu yaz ve çık
+static void draw_bench_done(void *user_data)
+{
+    draw_bench_t *bench = user_data;
+
+    draw_bench_print(stdout, bench);
+    exit(EXIT_SUCCESS);
+}
+
+// Sıcaklık ve güç etiketlerinin yerine önceden çizilmiş rakamlar
+static void numeric_displays_init(void)
+{
+    // Grafiklerin üstünde kalmaları için şerit grafiklerden sonra oluşturulur
+    if (numeric_display_init(&temperature_display, ui_Label3, "C", 8) == 0) {
+        readout_set_display(&temperature_readout, &temperature_display);
+    }
+    if (numeric_display_init(&power_display, ui_Label5, "W", 8) == 0) {
+        readout_set_display(&power_readout, &power_display);
+    }
+}
+
 int main(int argc, char **argv)
 {
+    startup_prof_init();
     configure_simulator(argc, argv);
+    device_shadow_init();
+    startup_prof_mark("configure_simulator");
 
     /* Initialize LVGL. */
     lv_init();
+    startup_prof_mark("lv_init");
 
     /* Initialize the configured backend */
     if (driver_backends_init_backend(selected_backend) == -1) {
@@ -867,9 +1134,17 @@ int main(int argc, char **argv)
         die("Failed to initialize evdev");
     }
 #endif
+    startup_prof_mark("backend init");
 
     /* Initialize UI */
+    size_t heap_before = obj_stats_heap_used();
     ui_init();
+    startup_prof_mark("ui_init");
+    if (measure_styles) {
+        obj_stats_t stats = { 0 };
+        obj_stats_collect(ui_Screen1, &stats);
+        obj_stats_print(stdout, "ui_Screen1", &stats, heap_before, obj_stats_heap_used());
+    }
     lv_obj_t * ui_btnMinus1 = lv_label_create(ui_Button2);          /*Add a label to the button*/
      lv_label_set_text(ui_btnMinus1, LV_SYMBOL_MINUS);                     /*Set the labels text*/
      lv_obj_set_style_text_color(ui_btnMinus1, lv_color_hex(0x808080), LV_PART_MAIN | LV_STATE_DEFAULT);
@@ -890,17 +1165,19 @@ int main(int argc, char **argv)
      lv_label_set_text(ui_btnPlus2, LV_SYMBOL_PLUS);                     /*Set the labels text*/
      lv_obj_center(ui_btnPlus2);
      lv_obj_set_style_text_color(ui_btnPlus2, lv_color_hex(0x808080), LV_PART_MAIN | LV_STATE_DEFAULT);
-     lv_example_list_1();
+    /* Widgets that can wait are built after the first frame */
+    startup_prof_defer("lv_example_list_1", lv_example_list_1);
+    startup_prof_defer("lv_example_line_1", lv_example_line_1);
+
     /* Create additional UI elements */
     create_ui();
+    startup_prof_mark("create_ui");
     lv_obj_add_event_cb(ui_Switch1, event_handler, LV_EVENT_ALL, NULL);
     lv_obj_add_event_cb(ui_Button2, button_event_handler, LV_EVENT_CLICKED, NULL);
     lv_obj_add_event_cb(ui_Button3, button_event_handler, LV_EVENT_CLICKED, NULL);
     lv_obj_add_event_cb(ui_Button4, button_event_handler, LV_EVENT_CLICKED, NULL);
     lv_obj_add_event_cb(ui_Button5, button_event_handler, LV_EVENT_CLICKED, NULL);
 
-
-    lv_example_line_1();
     /* Verify critical UI objects */
     if (ui_Dropdown2 == NULL || ui_Button1 == NULL || ui_StatusLabel == NULL) {
         printf("Critical UI objects not initialized!\n");
@@ -909,7 +1186,44 @@ int main(int argc, char **argv)
 
     /* Apply gradient effects if charts exist */
     if (ui_Chart1 && ui_Chart2 && ui_Chart3) {
-        lv_example_chart_gradient();
+        if (use_lv_chart) {
+            lv_example_chart_gradient();
+            charts_bind();
+        } else {
+            strip_charts_init();
+        }
+    }
+    startup_prof_mark("charts");
+
+    /* Readouts of the milli-unit values, one decimal */
+    readout_init(&temperature_readout, ui_Label3, 3, 1, " ", " C\n");
+    readout_init(&power_readout, ui_Label5, 3, 1, " ", " W\n");
+    startup_prof_defer("numeric displays", numeric_displays_init);
+
+    /* Labels and charts follow the samples at their own frame rate */
+    frame_governor_init(&ui_governor, ui_fps, ui_fps_adaptive, ui_frame_cb, NULL);
+
+    /* Replay a capture instead of waiting for a connection */
+    if (replay_path != NULL) {
+        serial_events_start();
+        if (serial_io_start_replay(replay_path, replay_speed) != 0) {
+            die("Failed to replay %s\n", replay_path);
+        }
+        is_reading = true;
+        lv_obj_add_state(ui_Dropdown2, LV_STATE_DISABLED);
+        lv_obj_add_state(ui_Button1, LV_STATE_DISABLED);
+    }
+
+    /* Ctrl-C and SIGTERM exit through atexit, the capture is closed */
+    quit_signals_init();
+
+    /* Time the first frame, then build the deferred widgets */
+    startup_prof_watch(lv_display_get_default(), print_startup);
+
+    /* Measure the frame time of the whole dashboard */
+    if (bench_frames > 0) {
+        static draw_bench_t bench;
+        draw_bench_start(&bench, lv_display_get_default(), bench_frames, draw_bench_done, &bench);
     }
 
     /* Enter the run loop of the selected backend */
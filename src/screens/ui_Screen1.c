@@ -5,12 +5,226 @@
 
 #include "../ui.h"
 
+///////////////////// STYLES ////////////////////
+
+// Every object of a role shares one constant style: nothing is allocated per object
+// and the properties are not copied. Add them after creation so they win over the theme.
+
+static const lv_style_const_prop_t style_screen_props[] = {
+    LV_STYLE_CONST_BG_COLOR(LV_COLOR_MAKE(0x1F, 0x1F, 0x1F)),
+    LV_STYLE_CONST_BG_OPA(255),
+    LV_STYLE_CONST_PROPS_END
+};
+static LV_STYLE_CONST_INIT(style_screen, style_screen_props);
+
+// Panels: flat, no border, invisible outline
+static const lv_style_const_prop_t style_panel_props[] = {
+    LV_STYLE_CONST_RADIUS(0),
+    LV_STYLE_CONST_BG_OPA(255),
+    LV_STYLE_CONST_BORDER_COLOR(LV_COLOR_MAKE(0x00, 0x00, 0x00)),
+    LV_STYLE_CONST_BORDER_OPA(0),
+    LV_STYLE_CONST_OUTLINE_COLOR(LV_COLOR_MAKE(0x00, 0x00, 0x00)),
+    LV_STYLE_CONST_OUTLINE_OPA(0),
+    LV_STYLE_CONST_OUTLINE_WIDTH(1),
+    LV_STYLE_CONST_OUTLINE_PAD(0),
+    LV_STYLE_CONST_PROPS_END
+};
+static LV_STYLE_CONST_INIT(style_panel, style_panel_props);
+
+static const lv_style_const_prop_t style_panel_dark_props[] = {
+    LV_STYLE_CONST_BG_COLOR(LV_COLOR_MAKE(0x14, 0x14, 0x14)),
+    LV_STYLE_CONST_PROPS_END
+};
+static LV_STYLE_CONST_INIT(style_panel_dark, style_panel_dark_props);
+
+static const lv_style_const_prop_t style_panel_light_props[] = {
+    LV_STYLE_CONST_BG_COLOR(LV_COLOR_MAKE(0x2B, 0x2B, 0x2B)),
+    LV_STYLE_CONST_PROPS_END
+};
+static LV_STYLE_CONST_INIT(style_panel_light, style_panel_light_props);
+
+// Charts: the plot of a dark panel, without division lines
+static const lv_style_const_prop_t style_chart_props[] = {
+    LV_STYLE_CONST_RADIUS(0),
+    LV_STYLE_CONST_BG_COLOR(LV_COLOR_MAKE(0x14, 0x14, 0x14)),
+    LV_STYLE_CONST_BG_OPA(255),
+    LV_STYLE_CONST_BORDER_COLOR(LV_COLOR_MAKE(0x00, 0x00, 0x00)),
+    LV_STYLE_CONST_BORDER_OPA(0),
+    LV_STYLE_CONST_LINE_COLOR(LV_COLOR_MAKE(0x40, 0x40, 0xFF)),
+    LV_STYLE_CONST_LINE_OPA(0),
+    //This workaround (an invisible outline) is needed because without it chart overflow-visible doesn't work in LVGL-9.1
+    LV_STYLE_CONST_OUTLINE_PAD(LV_MAX3(50, 50, 25)),
+    LV_STYLE_CONST_OUTLINE_WIDTH(-1),
+    LV_STYLE_CONST_PROPS_END
+};
+static LV_STYLE_CONST_INIT(style_chart, style_chart_props);
+
+static const lv_style_const_prop_t style_chart_series_props[] = {
+    LV_STYLE_CONST_LINE_WIDTH(2),
+    LV_STYLE_CONST_PROPS_END
+};
+static LV_STYLE_CONST_INIT(style_chart_series, style_chart_series_props);
+
+static const lv_style_const_prop_t style_chart_point_props[] = {
+    LV_STYLE_CONST_WIDTH(0),
+    LV_STYLE_CONST_HEIGHT(0),
+    LV_STYLE_CONST_PROPS_END
+};
+static LV_STYLE_CONST_INIT(style_chart_point, style_chart_point_props);
+
+// Axes: hidden ticks, labels hidden unless style_axis_label is added
+static const lv_style_const_prop_t style_axis_props[] = {
+    LV_STYLE_CONST_LINE_WIDTH(0),
+    LV_STYLE_CONST_TEXT_COLOR(LV_COLOR_MAKE(0xFF, 0xFF, 0xFF)),
+    LV_STYLE_CONST_TEXT_OPA(0),
+    LV_STYLE_CONST_PROPS_END
+};
+static LV_STYLE_CONST_INIT(style_axis, style_axis_props);
+
+static const lv_style_const_prop_t style_axis_minor_props[] = {
+    LV_STYLE_CONST_LINE_WIDTH(1),      //LVGL-9.1 ticks are thicker by default
+    LV_STYLE_CONST_LENGTH(5),
+    LV_STYLE_CONST_LINE_COLOR(LV_COLOR_MAKE(0x40, 0x40, 0xFF)),
+    LV_STYLE_CONST_LINE_OPA(0),
+    LV_STYLE_CONST_PROPS_END
+};
+static LV_STYLE_CONST_INIT(style_axis_minor, style_axis_minor_props);
+
+static const lv_style_const_prop_t style_axis_major_props[] = {
+    LV_STYLE_CONST_LINE_WIDTH(1),
+    LV_STYLE_CONST_LENGTH(10),
+    LV_STYLE_CONST_LINE_COLOR(LV_COLOR_MAKE(0x40, 0x40, 0xFF)),
+    LV_STYLE_CONST_LINE_OPA(0),
+    LV_STYLE_CONST_PROPS_END
+};
+static LV_STYLE_CONST_INIT(style_axis_major, style_axis_major_props);
+
+static const lv_style_const_prop_t style_axis_label_props[] = {
+    LV_STYLE_CONST_TEXT_OPA(150),
+    LV_STYLE_CONST_TEXT_ALIGN(LV_TEXT_ALIGN_AUTO),
+    LV_STYLE_CONST_TEXT_FONT(&lv_font_montserrat_14),
+    LV_STYLE_CONST_PROPS_END
+};
+static LV_STYLE_CONST_INIT(style_axis_label, style_axis_label_props);
+
+// Readouts and panel titles
+static const lv_style_const_prop_t style_readout_props[] = {
+    LV_STYLE_CONST_TEXT_COLOR(LV_COLOR_MAKE(0xFF, 0xFF, 0xFF)),
+    LV_STYLE_CONST_TEXT_OPA(255),
+    LV_STYLE_CONST_PROPS_END
+};
+static LV_STYLE_CONST_INIT(style_readout, style_readout_props);
+
+static const lv_style_const_prop_t style_heading_props[] = {
+    LV_STYLE_CONST_TEXT_COLOR(LV_COLOR_MAKE(0xF2, 0xEC, 0xEC)),
+    LV_STYLE_CONST_TEXT_OPA(255),
+    LV_STYLE_CONST_TEXT_FONT(&lv_font_montserrat_20),
+    LV_STYLE_CONST_PROPS_END
+};
+static LV_STYLE_CONST_INIT(style_heading, style_heading_props);
+
+static const lv_style_const_prop_t style_text_muted_props[] = {
+    LV_STYLE_CONST_TEXT_COLOR(LV_COLOR_MAKE(0x80, 0x80, 0x80)),
+    LV_STYLE_CONST_TEXT_OPA(255),
+    LV_STYLE_CONST_PROPS_END
+};
+static LV_STYLE_CONST_INIT(style_text_muted, style_text_muted_props);
+
+// Buttons, set point spinboxes and the port dropdown
+static const lv_style_const_prop_t style_button_props[] = {
+    LV_STYLE_CONST_RADIUS(0),
+    LV_STYLE_CONST_BG_COLOR(LV_COLOR_MAKE(0x2B, 0x2B, 0x2B)),
+    LV_STYLE_CONST_BG_OPA(255),
+    LV_STYLE_CONST_PROPS_END
+};
+static LV_STYLE_CONST_INIT(style_button, style_button_props);
+
+static const lv_style_const_prop_t style_button_connect_props[] = {
+    LV_STYLE_CONST_BG_COLOR(LV_COLOR_MAKE(0x1F, 0x1F, 0x1F)),
+    LV_STYLE_CONST_BG_OPA(255),
+    LV_STYLE_CONST_OUTLINE_WIDTH(1),
+    LV_STYLE_CONST_OUTLINE_PAD(0),
+    LV_STYLE_CONST_SHADOW_COLOR(LV_COLOR_MAKE(0x00, 0x00, 0x00)),
+    LV_STYLE_CONST_SHADOW_OPA(0),
+    LV_STYLE_CONST_PROPS_END
+};
+static LV_STYLE_CONST_INIT(style_button_connect, style_button_connect_props);
+
+static const lv_style_const_prop_t style_switch_props[] = {
+    LV_STYLE_CONST_BG_COLOR(LV_COLOR_MAKE(0xFF, 0xFF, 0xFF)),
+    LV_STYLE_CONST_BG_OPA(255),
+    LV_STYLE_CONST_PROPS_END
+};
+static LV_STYLE_CONST_INIT(style_switch, style_switch_props);
+
+static const lv_style_const_prop_t style_spinbox_props[] = {
+    LV_STYLE_CONST_RADIUS(0),
+    LV_STYLE_CONST_BG_COLOR(LV_COLOR_MAKE(0x2B, 0x2B, 0x2B)),
+    LV_STYLE_CONST_BG_OPA(255),
+    LV_STYLE_CONST_BORDER_COLOR(LV_COLOR_MAKE(0x00, 0x00, 0x00)),
+    LV_STYLE_CONST_BORDER_OPA(0),
+    LV_STYLE_CONST_TEXT_COLOR(LV_COLOR_MAKE(0x80, 0x80, 0x80)),
+    LV_STYLE_CONST_TEXT_OPA(255),
+    LV_STYLE_CONST_TEXT_FONT(&lv_font_montserrat_20),
+    LV_STYLE_CONST_PROPS_END
+};
+static LV_STYLE_CONST_INIT(style_spinbox, style_spinbox_props);
+
+static const lv_style_const_prop_t style_text_center_props[] = {
+    LV_STYLE_CONST_TEXT_ALIGN(LV_TEXT_ALIGN_CENTER),
+    LV_STYLE_CONST_PROPS_END
+};
+static LV_STYLE_CONST_INIT(style_text_center, style_text_center_props);
+
+static const lv_style_const_prop_t style_dropdown_props[] = {
+    LV_STYLE_CONST_TEXT_COLOR(LV_COLOR_MAKE(0x80, 0x80, 0x80)),
+    LV_STYLE_CONST_TEXT_OPA(255),
+    LV_STYLE_CONST_BG_COLOR(LV_COLOR_MAKE(0x1F, 0x1F, 0x1F)),
+    LV_STYLE_CONST_BG_OPA(255),
+    LV_STYLE_CONST_BORDER_COLOR(LV_COLOR_MAKE(0x00, 0x00, 0x00)),
+    LV_STYLE_CONST_BORDER_OPA(0),
+    LV_STYLE_CONST_PROPS_END
+};
+static LV_STYLE_CONST_INIT(style_dropdown, style_dropdown_props);
+
+static const lv_style_const_prop_t style_dropdown_list_props[] = {
+    LV_STYLE_CONST_TEXT_COLOR(LV_COLOR_MAKE(0xCC, 0xA2, 0x10)),
+    LV_STYLE_CONST_TEXT_OPA(255),
+    LV_STYLE_CONST_BG_COLOR(LV_COLOR_MAKE(0x1F, 0x1F, 0x1F)),
+    LV_STYLE_CONST_BG_OPA(255),
+    LV_STYLE_CONST_BORDER_COLOR(LV_COLOR_MAKE(0x00, 0x00, 0x00)),
+    LV_STYLE_CONST_BORDER_OPA(0),
+    LV_STYLE_CONST_OUTLINE_COLOR(LV_COLOR_MAKE(0x00, 0x00, 0x00)),
+    LV_STYLE_CONST_OUTLINE_OPA(0),
+    LV_STYLE_CONST_SHADOW_COLOR(LV_COLOR_MAKE(0x00, 0x00, 0x00)),
+    LV_STYLE_CONST_SHADOW_OPA(0),
+    LV_STYLE_CONST_PROPS_END
+};
+static LV_STYLE_CONST_INIT(style_dropdown_list, style_dropdown_list_props);
+
+///////////////////// FUNCTIONS ////////////////////
+
+// The styles of the three charts and their axes
+static void chart_add_styles(lv_obj_t * chart, lv_obj_t * xaxis, lv_obj_t * yaxis1, lv_obj_t * yaxis2)
+{
+    lv_obj_t * axes[] = { xaxis, yaxis1, yaxis2 };
+
+    lv_obj_add_style(chart, &style_chart, LV_PART_MAIN | LV_STATE_DEFAULT);
+    lv_obj_add_style(chart, &style_chart_series, LV_PART_ITEMS | LV_STATE_DEFAULT);
+    lv_obj_add_style(chart, &style_chart_point, LV_PART_INDICATOR | LV_STATE_DEFAULT);
+
+    for(uint32_t i = 0; i < sizeof(axes) / sizeof(axes[0]); i++) {
+        lv_obj_add_style(axes[i], &style_axis, LV_PART_MAIN | LV_STATE_DEFAULT);
+        lv_obj_add_style(axes[i], &style_axis_minor, LV_PART_ITEMS | LV_STATE_DEFAULT);
+        lv_obj_add_style(axes[i], &style_axis_major, LV_PART_INDICATOR | LV_STATE_DEFAULT);
+    }
+}
+
 void ui_Screen1_screen_init(void)
 {
     ui_Screen1 = lv_obj_create(NULL);
     lv_obj_remove_flag(ui_Screen1, LV_OBJ_FLAG_SCROLLABLE);      /// Flags
-    lv_obj_set_style_bg_color(ui_Screen1, lv_color_hex(0x1F1F1F), LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_bg_opa(ui_Screen1, 255, LV_PART_MAIN | LV_STATE_DEFAULT);
+    lv_obj_add_style(ui_Screen1, &style_screen, LV_PART_MAIN | LV_STATE_DEFAULT);
 
     ui_Panel1 = lv_obj_create(ui_Screen1);
     lv_obj_set_width(ui_Panel1, 800);
@@ -19,15 +233,8 @@ void ui_Screen1_screen_init(void)
     lv_obj_set_y(ui_Panel1, -215);
     lv_obj_set_align(ui_Panel1, LV_ALIGN_CENTER);
     lv_obj_remove_flag(ui_Panel1, LV_OBJ_FLAG_SCROLLABLE);      /// Flags
-    lv_obj_set_style_radius(ui_Panel1, 0, LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_bg_color(ui_Panel1, lv_color_hex(0x141414), LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_bg_opa(ui_Panel1, 255, LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_border_color(ui_Panel1, lv_color_hex(0x000000), LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_border_opa(ui_Panel1, 0, LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_outline_color(ui_Panel1, lv_color_hex(0x000000), LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_outline_opa(ui_Panel1, 0, LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_outline_width(ui_Panel1, 1, LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_outline_pad(ui_Panel1, 0, LV_PART_MAIN | LV_STATE_DEFAULT);
+    lv_obj_add_style(ui_Panel1, &style_panel, LV_PART_MAIN | LV_STATE_DEFAULT);
+    lv_obj_add_style(ui_Panel1, &style_panel_dark, LV_PART_MAIN | LV_STATE_DEFAULT);
 
     ui_Dropdown2 = lv_dropdown_create(ui_Panel1);
     lv_dropdown_set_options(ui_Dropdown2, "Option 1\nOption 2\nOption 3");
@@ -37,27 +244,8 @@ void ui_Screen1_screen_init(void)
     lv_obj_set_y(ui_Dropdown2, 0);
     lv_obj_set_align(ui_Dropdown2, LV_ALIGN_CENTER);
     lv_obj_add_flag(ui_Dropdown2, LV_OBJ_FLAG_SCROLL_ON_FOCUS);     /// Flags
-    lv_obj_set_style_text_color(ui_Dropdown2, lv_color_hex(0x808080), LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_text_opa(ui_Dropdown2, 255, LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_bg_color(ui_Dropdown2, lv_color_hex(0x1F1F1F), LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_bg_opa(ui_Dropdown2, 255, LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_border_color(ui_Dropdown2, lv_color_hex(0x000000), LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_border_opa(ui_Dropdown2, 0, LV_PART_MAIN | LV_STATE_DEFAULT);
-
-    lv_obj_set_style_text_color(lv_dropdown_get_list(ui_Dropdown2), lv_color_hex(0xCCA210),
-                                LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_text_opa(lv_dropdown_get_list(ui_Dropdown2), 255,  LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_bg_color(lv_dropdown_get_list(ui_Dropdown2), lv_color_hex(0x1F1F1F),  LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_bg_opa(lv_dropdown_get_list(ui_Dropdown2), 255,  LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_border_color(lv_dropdown_get_list(ui_Dropdown2), lv_color_hex(0x000000),
-                                  LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_border_opa(lv_dropdown_get_list(ui_Dropdown2), 0,  LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_outline_color(lv_dropdown_get_list(ui_Dropdown2), lv_color_hex(0x000000),
-                                   LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_outline_opa(lv_dropdown_get_list(ui_Dropdown2), 0,  LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_shadow_color(lv_dropdown_get_list(ui_Dropdown2), lv_color_hex(0x000000),
-                                  LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_shadow_opa(lv_dropdown_get_list(ui_Dropdown2), 0,  LV_PART_MAIN | LV_STATE_DEFAULT);
+    lv_obj_add_style(ui_Dropdown2, &style_dropdown, LV_PART_MAIN | LV_STATE_DEFAULT);
+    lv_obj_add_style(lv_dropdown_get_list(ui_Dropdown2), &style_dropdown_list, LV_PART_MAIN | LV_STATE_DEFAULT);
 
     ui_Button1 = lv_button_create(ui_Panel1);
     lv_obj_set_width(ui_Button1, 100);
@@ -67,12 +255,7 @@ void ui_Screen1_screen_init(void)
     lv_obj_set_align(ui_Button1, LV_ALIGN_CENTER);
     lv_obj_add_flag(ui_Button1, LV_OBJ_FLAG_SCROLL_ON_FOCUS);     /// Flags
     lv_obj_remove_flag(ui_Button1, LV_OBJ_FLAG_SCROLLABLE);      /// Flags
-    lv_obj_set_style_bg_color(ui_Button1, lv_color_hex(0x1F1F1F), LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_bg_opa(ui_Button1, 255, LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_outline_width(ui_Button1, 1, LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_outline_pad(ui_Button1, 0, LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_shadow_color(ui_Button1, lv_color_hex(0x000000), LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_shadow_opa(ui_Button1, 0, LV_PART_MAIN | LV_STATE_DEFAULT);
+    lv_obj_add_style(ui_Button1, &style_button_connect, LV_PART_MAIN | LV_STATE_DEFAULT);
 
     ui_Switch1 = lv_switch_create(ui_Panel1);
     lv_obj_set_width(ui_Switch1, 50);
@@ -80,14 +263,9 @@ void ui_Screen1_screen_init(void)
     lv_obj_set_x(ui_Switch1, 355);
     lv_obj_set_y(ui_Switch1, 0);
     lv_obj_set_align(ui_Switch1, LV_ALIGN_CENTER);
-    lv_obj_set_style_bg_color(ui_Switch1, lv_color_hex(0xFFFFFF), LV_PART_MAIN | LV_STATE_CHECKED);
-    lv_obj_set_style_bg_opa(ui_Switch1, 255, LV_PART_MAIN | LV_STATE_CHECKED);
-
-    lv_obj_set_style_bg_color(ui_Switch1, lv_color_hex(0xFFFFFF), LV_PART_INDICATOR | LV_STATE_PRESSED);
-    lv_obj_set_style_bg_opa(ui_Switch1, 255, LV_PART_INDICATOR | LV_STATE_PRESSED);
-
-    lv_obj_set_style_bg_color(ui_Switch1, lv_color_hex(0xFFFFFF), LV_PART_KNOB | LV_STATE_DEFAULT);
-    lv_obj_set_style_bg_opa(ui_Switch1, 255, LV_PART_KNOB | LV_STATE_DEFAULT);
+    lv_obj_add_style(ui_Switch1, &style_switch, LV_PART_MAIN | LV_STATE_CHECKED);
+    lv_obj_add_style(ui_Switch1, &style_switch, LV_PART_INDICATOR | LV_STATE_PRESSED);
+    lv_obj_add_style(ui_Switch1, &style_switch, LV_PART_KNOB | LV_STATE_DEFAULT);
 
     ui_Panel2 = lv_obj_create(ui_Screen1);
     lv_obj_set_width(ui_Panel2, 290);
@@ -96,15 +274,8 @@ void ui_Screen1_screen_init(void)
     lv_obj_set_y(ui_Panel2, 130);
     lv_obj_set_align(ui_Panel2, LV_ALIGN_CENTER);
     lv_obj_remove_flag(ui_Panel2, LV_OBJ_FLAG_SCROLLABLE);      /// Flags
-    lv_obj_set_style_radius(ui_Panel2, 0, LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_bg_color(ui_Panel2, lv_color_hex(0x141414), LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_bg_opa(ui_Panel2, 255, LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_border_color(ui_Panel2, lv_color_hex(0x000000), LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_border_opa(ui_Panel2, 0, LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_outline_color(ui_Panel2, lv_color_hex(0x000000), LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_outline_opa(ui_Panel2, 0, LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_outline_width(ui_Panel2, 1, LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_outline_pad(ui_Panel2, 0, LV_PART_MAIN | LV_STATE_DEFAULT);
+    lv_obj_add_style(ui_Panel2, &style_panel, LV_PART_MAIN | LV_STATE_DEFAULT);
+    lv_obj_add_style(ui_Panel2, &style_panel_dark, LV_PART_MAIN | LV_STATE_DEFAULT);
 
     ui_Label1 = lv_label_create(ui_Panel2);
     lv_obj_set_width(ui_Label1, LV_SIZE_CONTENT);   /// 1
@@ -113,9 +284,7 @@ void ui_Screen1_screen_init(void)
     lv_obj_set_y(ui_Label1, -81);
     lv_obj_set_align(ui_Label1, LV_ALIGN_CENTER);
     lv_label_set_text(ui_Label1, "PRESET ");
-    lv_obj_set_style_text_color(ui_Label1, lv_color_hex(0xF2ECEC), LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_text_opa(ui_Label1, 255, LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_text_font(ui_Label1, &lv_font_montserrat_20, LV_PART_MAIN | LV_STATE_DEFAULT);
+    lv_obj_add_style(ui_Label1, &style_heading, LV_PART_MAIN | LV_STATE_DEFAULT);
 
     ui_Label2 = lv_label_create(ui_Screen1);
     lv_obj_set_width(ui_Label2, LV_SIZE_CONTENT);   /// 1
@@ -132,15 +301,8 @@ void ui_Screen1_screen_init(void)
     lv_obj_set_y(ui_Panel3, -129);
     lv_obj_set_align(ui_Panel3, LV_ALIGN_CENTER);
     lv_obj_remove_flag(ui_Panel3, LV_OBJ_FLAG_SCROLLABLE);      /// Flags
-    lv_obj_set_style_radius(ui_Panel3, 0, LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_bg_color(ui_Panel3, lv_color_hex(0x2B2B2B), LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_bg_opa(ui_Panel3, 255, LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_border_color(ui_Panel3, lv_color_hex(0x000000), LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_border_opa(ui_Panel3, 0, LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_outline_color(ui_Panel3, lv_color_hex(0x000000), LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_outline_opa(ui_Panel3, 0, LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_outline_width(ui_Panel3, 1, LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_outline_pad(ui_Panel3, 0, LV_PART_MAIN | LV_STATE_DEFAULT);
+    lv_obj_add_style(ui_Panel3, &style_panel, LV_PART_MAIN | LV_STATE_DEFAULT);
+    lv_obj_add_style(ui_Panel3, &style_panel_light, LV_PART_MAIN | LV_STATE_DEFAULT);
 
     ui_Chart1 = lv_chart_create(ui_Panel3);
     lv_obj_set_width(ui_Chart1, 247);
@@ -153,13 +315,6 @@ void ui_Screen1_screen_init(void)
     lv_obj_add_flag(ui_Chart1, LV_OBJ_FLAG_OVERFLOW_VISIBLE);      //make scales visible - Should it be forced to True?
     //lv_obj_remove_flag( ui_Chart1, LV_OBJ_FLAG_SCROLLABLE );    //no chart-zoom in LVGL9 - Shouldn't it be forced to False?
     lv_chart_set_type(ui_Chart1, LV_CHART_TYPE_LINE);
-    lv_obj_set_style_radius(ui_Chart1, 0, LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_bg_color(ui_Chart1, lv_color_hex(0x141414), LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_bg_opa(ui_Chart1, 255, LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_border_color(ui_Chart1, lv_color_hex(0x000000), LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_border_opa(ui_Chart1, 0, LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_line_color(ui_Chart1, lv_color_hex(0x4040FF), LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_line_opa(ui_Chart1, 0, LV_PART_MAIN | LV_STATE_DEFAULT);
 
     ui_Chart1_Xaxis = lv_scale_create(ui_Chart1);
     lv_scale_set_mode(ui_Chart1_Xaxis, LV_SCALE_MODE_HORIZONTAL_BOTTOM);
@@ -167,11 +322,6 @@ void ui_Screen1_screen_init(void)
     lv_obj_set_align(ui_Chart1_Xaxis, LV_ALIGN_BOTTOM_MID);
     lv_obj_set_y(ui_Chart1_Xaxis, 50 + lv_obj_get_style_pad_bottom(ui_Chart1,
                                                                    LV_PART_MAIN) + lv_obj_get_style_border_width(ui_Chart1, LV_PART_MAIN));
-    lv_obj_set_style_line_width(ui_Chart1_Xaxis, 0, LV_PART_MAIN);
-    lv_obj_set_style_line_width(ui_Chart1_Xaxis, 1, LV_PART_ITEMS);   //LVGL-9.1 ticks are thicker by default
-    lv_obj_set_style_line_width(ui_Chart1_Xaxis, 1, LV_PART_INDICATOR);
-    lv_obj_set_style_length(ui_Chart1_Xaxis, 5, LV_PART_ITEMS);      //minor tick length
-    lv_obj_set_style_length(ui_Chart1_Xaxis, 10, LV_PART_INDICATOR);      //major tick length
     lv_scale_set_range(ui_Chart1_Xaxis, 0, 5 > 0 ? 5 - 1 : 0);
     lv_scale_set_total_tick_count(ui_Chart1_Xaxis, (5 > 0 ? 5 - 1 : 0) * 2 + 1);
     lv_scale_set_major_tick_every(ui_Chart1_Xaxis, 2 >= 1 ? 2 : 1);
@@ -181,11 +331,6 @@ void ui_Screen1_screen_init(void)
     lv_obj_set_align(ui_Chart1_Yaxis1, LV_ALIGN_LEFT_MID);
     lv_obj_set_x(ui_Chart1_Yaxis1, -50 - lv_obj_get_style_pad_left(ui_Chart1,
                                                                    LV_PART_MAIN) - lv_obj_get_style_border_width(ui_Chart1, LV_PART_MAIN) + 2);
-    lv_obj_set_style_line_width(ui_Chart1_Yaxis1, 0, LV_PART_MAIN);
-    lv_obj_set_style_line_width(ui_Chart1_Yaxis1, 1, LV_PART_ITEMS);
-    lv_obj_set_style_line_width(ui_Chart1_Yaxis1, 1, LV_PART_INDICATOR);
-    lv_obj_set_style_length(ui_Chart1_Yaxis1, 5, LV_PART_ITEMS);   //minor tick length
-    lv_obj_set_style_length(ui_Chart1_Yaxis1, 10, LV_PART_INDICATOR);   //major tick length
     lv_scale_set_total_tick_count(ui_Chart1_Yaxis1, (5 > 0 ? 5 - 1 : 0) * 2 + 1);
     lv_scale_set_major_tick_every(ui_Chart1_Yaxis1, 2 >= 1 ? 2 : 1);
     ui_Chart1_Yaxis2 = lv_scale_create(ui_Chart1);
@@ -194,11 +339,6 @@ void ui_Screen1_screen_init(void)
     lv_obj_set_align(ui_Chart1_Yaxis2, LV_ALIGN_RIGHT_MID);
     lv_obj_set_x(ui_Chart1_Yaxis2, 25 + lv_obj_get_style_pad_right(ui_Chart1,
                                                                    LV_PART_MAIN) + lv_obj_get_style_border_width(ui_Chart1, LV_PART_MAIN) + 1);
-    lv_obj_set_style_line_width(ui_Chart1_Yaxis2, 0, LV_PART_MAIN);
-    lv_obj_set_style_line_width(ui_Chart1_Yaxis2, 1, LV_PART_ITEMS);
-    lv_obj_set_style_line_width(ui_Chart1_Yaxis2, 1, LV_PART_INDICATOR);
-    lv_obj_set_style_length(ui_Chart1_Yaxis2, 5, LV_PART_ITEMS);   //minor tick length
-    lv_obj_set_style_length(ui_Chart1_Yaxis2, 10, LV_PART_INDICATOR);   //major tick length
     lv_scale_set_total_tick_count(ui_Chart1_Yaxis2, (5 > 0 ? 5 - 1 : 0) * 2 + 1);
     lv_scale_set_major_tick_every(ui_Chart1_Yaxis2, 2 >= 1 ? 2 : 1);
     lv_chart_series_t * ui_Chart1_series_1 = lv_chart_add_series(ui_Chart1, lv_color_hex(0x9E10D0),
@@ -206,33 +346,8 @@ void ui_Screen1_screen_init(void)
     static lv_coord_t ui_Chart1_series_1_array[] = { 0, 10, 20, 40, 80, 80, 40, 20, 10, 0 };
     lv_chart_set_ext_y_array(ui_Chart1, ui_Chart1_series_1, ui_Chart1_series_1_array);
 
-    lv_obj_set_style_line_width(ui_Chart1, 2, LV_PART_ITEMS | LV_STATE_DEFAULT);
-
-    lv_obj_set_style_size(ui_Chart1, 0, 0, LV_PART_INDICATOR | LV_STATE_DEFAULT);
-
-    lv_obj_set_style_line_color(ui_Chart1_Xaxis, lv_color_hex(0x4040FF), LV_PART_INDICATOR | LV_STATE_DEFAULT);
-    lv_obj_set_style_line_opa(ui_Chart1_Xaxis, 0, LV_PART_INDICATOR | LV_STATE_DEFAULT);
-    lv_obj_set_style_line_color(ui_Chart1_Yaxis1, lv_color_hex(0x4040FF), LV_PART_INDICATOR | LV_STATE_DEFAULT);
-    lv_obj_set_style_line_opa(ui_Chart1_Yaxis1, 0, LV_PART_INDICATOR | LV_STATE_DEFAULT);
-    lv_obj_set_style_line_color(ui_Chart1_Yaxis2, lv_color_hex(0x4040FF), LV_PART_INDICATOR | LV_STATE_DEFAULT);
-    lv_obj_set_style_line_opa(ui_Chart1_Yaxis2, 0, LV_PART_INDICATOR | LV_STATE_DEFAULT);
-    lv_obj_set_style_line_color(ui_Chart1_Xaxis, lv_color_hex(0x4040FF), LV_PART_ITEMS | LV_STATE_DEFAULT);
-    lv_obj_set_style_line_opa(ui_Chart1_Xaxis, 0, LV_PART_ITEMS | LV_STATE_DEFAULT);
-    lv_obj_set_style_line_color(ui_Chart1_Yaxis1, lv_color_hex(0x4040FF), LV_PART_ITEMS | LV_STATE_DEFAULT);
-    lv_obj_set_style_line_opa(ui_Chart1_Yaxis1, 0, LV_PART_ITEMS | LV_STATE_DEFAULT);
-    lv_obj_set_style_line_color(ui_Chart1_Yaxis2, lv_color_hex(0x4040FF), LV_PART_ITEMS | LV_STATE_DEFAULT);
-    lv_obj_set_style_line_opa(ui_Chart1_Yaxis2, 0, LV_PART_ITEMS | LV_STATE_DEFAULT);
-    lv_obj_set_style_text_color(ui_Chart1_Xaxis, lv_color_hex(0xFFFFFF), LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_text_opa(ui_Chart1_Xaxis, 0, LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_text_color(ui_Chart1_Yaxis1, lv_color_hex(0xFFFFFF), LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_text_opa(ui_Chart1_Yaxis1, 0, LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_text_color(ui_Chart1_Yaxis2, lv_color_hex(0xFFFFFF), LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_text_opa(ui_Chart1_Yaxis2, 0, LV_PART_MAIN | LV_STATE_DEFAULT);
+    chart_add_styles(ui_Chart1, ui_Chart1_Xaxis, ui_Chart1_Yaxis1, ui_Chart1_Yaxis2);
 
-    //This workaround (an invisible outline) is needed because without it chart overflow-visible doesn't work in LVGL-9.1
-    lv_obj_set_style_outline_pad(ui_Chart1, LV_MAX3(50, 50, 25),
-                                 LV_PART_MAIN | LV_STATE_DEFAULT);   //workaround for ineffective 'overflow visible' flag
-    lv_obj_set_style_outline_width(ui_Chart1, -1, LV_PART_MAIN | LV_STATE_DEFAULT);
     ui_Label3 = lv_label_create(ui_Chart1);
     lv_obj_set_width(ui_Label3, LV_SIZE_CONTENT);   /// 1
     lv_obj_set_height(ui_Label3, LV_SIZE_CONTENT);    /// 1
@@ -240,8 +355,7 @@ void ui_Screen1_screen_init(void)
     lv_obj_set_y(ui_Label3, -35);
     lv_obj_set_align(ui_Label3, LV_ALIGN_CENTER);
     lv_label_set_text(ui_Label3, "25 C");
-    lv_obj_set_style_text_color(ui_Label3, lv_color_hex(0xFFFFFF), LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_text_opa(ui_Label3, 255, LV_PART_MAIN | LV_STATE_DEFAULT);
+    lv_obj_add_style(ui_Label3, &style_readout, LV_PART_MAIN | LV_STATE_DEFAULT);
 
     ui_Label4 = lv_label_create(ui_Panel3);
     lv_obj_set_width(ui_Label4, LV_SIZE_CONTENT);   /// 1
@@ -250,8 +364,7 @@ void ui_Screen1_screen_init(void)
     lv_obj_set_y(ui_Label4, 5);
     lv_obj_set_align(ui_Label4, LV_ALIGN_CENTER);
     lv_label_set_text(ui_Label4, "TEMP");
-    lv_obj_set_style_text_color(ui_Label4, lv_color_hex(0xFFFFFF), LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_text_opa(ui_Label4, 255, LV_PART_MAIN | LV_STATE_DEFAULT);
+    lv_obj_add_style(ui_Label4, &style_readout, LV_PART_MAIN | LV_STATE_DEFAULT);
 
     ui_Panel5 = lv_obj_create(ui_Screen1);
     lv_obj_set_width(ui_Panel5, 485);
@@ -260,17 +373,9 @@ void ui_Screen1_screen_init(void)
     lv_obj_set_y(ui_Panel5, 130);
     lv_obj_set_align(ui_Panel5, LV_ALIGN_CENTER);
     lv_obj_remove_flag(ui_Panel5, LV_OBJ_FLAG_SCROLLABLE);      /// Flags
-    lv_obj_set_style_radius(ui_Panel5, 0, LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_bg_color(ui_Panel5, lv_color_hex(0x141414), LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_bg_opa(ui_Panel5, 255, LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_border_color(ui_Panel5, lv_color_hex(0x000000), LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_border_opa(ui_Panel5, 0, LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_outline_color(ui_Panel5, lv_color_hex(0x000000), LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_outline_opa(ui_Panel5, 0, LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_outline_width(ui_Panel5, 1, LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_outline_pad(ui_Panel5, 0, LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_text_color(ui_Panel5, lv_color_hex(0x808080), LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_text_opa(ui_Panel5, 255, LV_PART_MAIN | LV_STATE_DEFAULT);
+    lv_obj_add_style(ui_Panel5, &style_panel, LV_PART_MAIN | LV_STATE_DEFAULT);
+    lv_obj_add_style(ui_Panel5, &style_panel_dark, LV_PART_MAIN | LV_STATE_DEFAULT);
+    lv_obj_add_style(ui_Panel5, &style_text_muted, LV_PART_MAIN | LV_STATE_DEFAULT);
 
     ui_Chart3 = lv_chart_create(ui_Panel5);
     lv_obj_set_width(ui_Chart3, 425);
@@ -284,13 +389,6 @@ void ui_Screen1_screen_init(void)
     //lv_obj_remove_flag( ui_Chart3, LV_OBJ_FLAG_SCROLLABLE );    //no chart-zoom in LVGL9 - Shouldn't it be forced to False?
     lv_chart_set_type(ui_Chart3, LV_CHART_TYPE_LINE);
     lv_chart_set_range(ui_Chart3, LV_CHART_AXIS_SECONDARY_Y, 0, 30);
-    lv_obj_set_style_radius(ui_Chart3, 0, LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_bg_color(ui_Chart3, lv_color_hex(0x141414), LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_bg_opa(ui_Chart3, 255, LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_border_color(ui_Chart3, lv_color_hex(0x000000), LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_border_opa(ui_Chart3, 0, LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_line_color(ui_Chart3, lv_color_hex(0x4040FF), LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_line_opa(ui_Chart3, 0, LV_PART_MAIN | LV_STATE_DEFAULT);
 
     ui_Chart3_Xaxis = lv_scale_create(ui_Chart3);
     lv_scale_set_mode(ui_Chart3_Xaxis, LV_SCALE_MODE_HORIZONTAL_BOTTOM);
@@ -298,11 +396,6 @@ void ui_Screen1_screen_init(void)
     lv_obj_set_align(ui_Chart3_Xaxis, LV_ALIGN_BOTTOM_MID);
     lv_obj_set_y(ui_Chart3_Xaxis, 50 + lv_obj_get_style_pad_bottom(ui_Chart3,
                                                                    LV_PART_MAIN) + lv_obj_get_style_border_width(ui_Chart3, LV_PART_MAIN));
-    lv_obj_set_style_line_width(ui_Chart3_Xaxis, 0, LV_PART_MAIN);
-    lv_obj_set_style_line_width(ui_Chart3_Xaxis, 1, LV_PART_ITEMS);   //LVGL-9.1 ticks are thicker by default
-    lv_obj_set_style_line_width(ui_Chart3_Xaxis, 1, LV_PART_INDICATOR);
-    lv_obj_set_style_length(ui_Chart3_Xaxis, 5, LV_PART_ITEMS);      //minor tick length
-    lv_obj_set_style_length(ui_Chart3_Xaxis, 10, LV_PART_INDICATOR);      //major tick length
     lv_scale_set_range(ui_Chart3_Xaxis, 0, 5 > 0 ? 5 - 1 : 0);
     lv_scale_set_total_tick_count(ui_Chart3_Xaxis, (5 > 0 ? 5 - 1 : 0) * 2 + 1);
     lv_scale_set_major_tick_every(ui_Chart3_Xaxis, 2 >= 1 ? 2 : 1);
@@ -312,11 +405,6 @@ void ui_Screen1_screen_init(void)
     lv_obj_set_align(ui_Chart3_Yaxis1, LV_ALIGN_LEFT_MID);
     lv_obj_set_x(ui_Chart3_Yaxis1, -50 - lv_obj_get_style_pad_left(ui_Chart3,
                                                                    LV_PART_MAIN) - lv_obj_get_style_border_width(ui_Chart3, LV_PART_MAIN) + 2);
-    lv_obj_set_style_line_width(ui_Chart3_Yaxis1, 0, LV_PART_MAIN);
-    lv_obj_set_style_line_width(ui_Chart3_Yaxis1, 1, LV_PART_ITEMS);
-    lv_obj_set_style_line_width(ui_Chart3_Yaxis1, 1, LV_PART_INDICATOR);
-    lv_obj_set_style_length(ui_Chart3_Yaxis1, 5, LV_PART_ITEMS);   //minor tick length
-    lv_obj_set_style_length(ui_Chart3_Yaxis1, 10, LV_PART_INDICATOR);   //major tick length
     lv_scale_set_total_tick_count(ui_Chart3_Yaxis1, (5 > 0 ? 5 - 1 : 0) * 2 + 1);
     lv_scale_set_major_tick_every(ui_Chart3_Yaxis1, 2 >= 1 ? 2 : 1);
     ui_Chart3_Yaxis2 = lv_scale_create(ui_Chart3);
@@ -325,11 +413,6 @@ void ui_Screen1_screen_init(void)
     lv_obj_set_align(ui_Chart3_Yaxis2, LV_ALIGN_RIGHT_MID);
     lv_obj_set_x(ui_Chart3_Yaxis2, 25 + lv_obj_get_style_pad_right(ui_Chart3,
                                                                    LV_PART_MAIN) + lv_obj_get_style_border_width(ui_Chart3, LV_PART_MAIN) + 1);
-    lv_obj_set_style_line_width(ui_Chart3_Yaxis2, 0, LV_PART_MAIN);
-    lv_obj_set_style_line_width(ui_Chart3_Yaxis2, 1, LV_PART_ITEMS);
-    lv_obj_set_style_line_width(ui_Chart3_Yaxis2, 1, LV_PART_INDICATOR);
-    lv_obj_set_style_length(ui_Chart3_Yaxis2, 5, LV_PART_ITEMS);   //minor tick length
-    lv_obj_set_style_length(ui_Chart3_Yaxis2, 10, LV_PART_INDICATOR);   //major tick length
     lv_scale_set_range(ui_Chart3_Yaxis2,  0, 30);
     lv_scale_set_total_tick_count(ui_Chart3_Yaxis2, (5 > 0 ? 5 - 1 : 0) * 2 + 1);
     lv_scale_set_major_tick_every(ui_Chart3_Yaxis2, 2 >= 1 ? 2 : 1);
@@ -342,39 +425,11 @@ void ui_Screen1_screen_init(void)
     static lv_coord_t ui_Chart3_series_2_array[] = { 0, 10, 20, 40, 8, 8, 40, 20, 10, 0 };
     lv_chart_set_ext_y_array(ui_Chart3, ui_Chart3_series_2, ui_Chart3_series_2_array);
 
-    lv_obj_set_style_line_width(ui_Chart3, 2, LV_PART_ITEMS | LV_STATE_DEFAULT);
-
-    lv_obj_set_style_size(ui_Chart3, 0, 0, LV_PART_INDICATOR | LV_STATE_DEFAULT);
-
-    lv_obj_set_style_line_color(ui_Chart3_Xaxis, lv_color_hex(0x4040FF), LV_PART_INDICATOR | LV_STATE_DEFAULT);
-    lv_obj_set_style_line_opa(ui_Chart3_Xaxis, 0, LV_PART_INDICATOR | LV_STATE_DEFAULT);
-    lv_obj_set_style_line_color(ui_Chart3_Yaxis1, lv_color_hex(0x4040FF), LV_PART_INDICATOR | LV_STATE_DEFAULT);
-    lv_obj_set_style_line_opa(ui_Chart3_Yaxis1, 0, LV_PART_INDICATOR | LV_STATE_DEFAULT);
-    lv_obj_set_style_line_color(ui_Chart3_Yaxis2, lv_color_hex(0x4040FF), LV_PART_INDICATOR | LV_STATE_DEFAULT);
-    lv_obj_set_style_line_opa(ui_Chart3_Yaxis2, 0, LV_PART_INDICATOR | LV_STATE_DEFAULT);
-    lv_obj_set_style_line_color(ui_Chart3_Xaxis, lv_color_hex(0x4040FF), LV_PART_ITEMS | LV_STATE_DEFAULT);
-    lv_obj_set_style_line_opa(ui_Chart3_Xaxis, 0, LV_PART_ITEMS | LV_STATE_DEFAULT);
-    lv_obj_set_style_line_color(ui_Chart3_Yaxis1, lv_color_hex(0x4040FF), LV_PART_ITEMS | LV_STATE_DEFAULT);
-    lv_obj_set_style_line_opa(ui_Chart3_Yaxis1, 0, LV_PART_ITEMS | LV_STATE_DEFAULT);
-    lv_obj_set_style_line_color(ui_Chart3_Yaxis2, lv_color_hex(0x4040FF), LV_PART_ITEMS | LV_STATE_DEFAULT);
-    lv_obj_set_style_line_opa(ui_Chart3_Yaxis2, 0, LV_PART_ITEMS | LV_STATE_DEFAULT);
-    lv_obj_set_style_text_color(ui_Chart3_Xaxis, lv_color_hex(0xFFFFFF), LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_text_opa(ui_Chart3_Xaxis, 150, LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_text_color(ui_Chart3_Yaxis1, lv_color_hex(0xFFFFFF), LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_text_opa(ui_Chart3_Yaxis1, 150, LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_text_color(ui_Chart3_Yaxis2, lv_color_hex(0xFFFFFF), LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_text_opa(ui_Chart3_Yaxis2, 150, LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_text_align(ui_Chart3_Xaxis, LV_TEXT_ALIGN_AUTO, LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_text_align(ui_Chart3_Yaxis1, LV_TEXT_ALIGN_AUTO, LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_text_align(ui_Chart3_Yaxis2, LV_TEXT_ALIGN_AUTO, LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_text_font(ui_Chart3_Xaxis, &lv_font_montserrat_14, LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_text_font(ui_Chart3_Yaxis1, &lv_font_montserrat_14, LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_text_font(ui_Chart3_Yaxis2, &lv_font_montserrat_14, LV_PART_MAIN | LV_STATE_DEFAULT);
+    chart_add_styles(ui_Chart3, ui_Chart3_Xaxis, ui_Chart3_Yaxis1, ui_Chart3_Yaxis2);
+    lv_obj_add_style(ui_Chart3_Xaxis, &style_axis_label, LV_PART_MAIN | LV_STATE_DEFAULT);
+    lv_obj_add_style(ui_Chart3_Yaxis1, &style_axis_label, LV_PART_MAIN | LV_STATE_DEFAULT);
+    lv_obj_add_style(ui_Chart3_Yaxis2, &style_axis_label, LV_PART_MAIN | LV_STATE_DEFAULT);
 
-    //This workaround (an invisible outline) is needed because without it chart overflow-visible doesn't work in LVGL-9.1
-    lv_obj_set_style_outline_pad(ui_Chart3, LV_MAX3(50, 50, 25),
-                                 LV_PART_MAIN | LV_STATE_DEFAULT);   //workaround for ineffective 'overflow visible' flag
-    lv_obj_set_style_outline_width(ui_Chart3, -1, LV_PART_MAIN | LV_STATE_DEFAULT);
     ui_Panel4 = lv_obj_create(ui_Screen1);
     lv_obj_set_width(ui_Panel4, 390);
     lv_obj_set_height(ui_Panel4, 100);
@@ -382,15 +437,8 @@ void ui_Screen1_screen_init(void)
     lv_obj_set_y(ui_Panel4, -25);
     lv_obj_set_align(ui_Panel4, LV_ALIGN_CENTER);
     lv_obj_remove_flag(ui_Panel4, LV_OBJ_FLAG_SCROLLABLE);      /// Flags
-    lv_obj_set_style_radius(ui_Panel4, 0, LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_bg_color(ui_Panel4, lv_color_hex(0x2B2B2B), LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_bg_opa(ui_Panel4, 255, LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_border_color(ui_Panel4, lv_color_hex(0x000000), LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_border_opa(ui_Panel4, 0, LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_outline_color(ui_Panel4, lv_color_hex(0x000000), LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_outline_opa(ui_Panel4, 0, LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_outline_width(ui_Panel4, 1, LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_outline_pad(ui_Panel4, 0, LV_PART_MAIN | LV_STATE_DEFAULT);
+    lv_obj_add_style(ui_Panel4, &style_panel, LV_PART_MAIN | LV_STATE_DEFAULT);
+    lv_obj_add_style(ui_Panel4, &style_panel_light, LV_PART_MAIN | LV_STATE_DEFAULT);
 
     ui_Chart2 = lv_chart_create(ui_Panel4);
     lv_obj_set_width(ui_Chart2, 247);
@@ -403,13 +451,6 @@ void ui_Screen1_screen_init(void)
     lv_obj_add_flag(ui_Chart2, LV_OBJ_FLAG_OVERFLOW_VISIBLE);      //make scales visible - Should it be forced to True?
     //lv_obj_remove_flag( ui_Chart2, LV_OBJ_FLAG_SCROLLABLE );    //no chart-zoom in LVGL9 - Shouldn't it be forced to False?
     lv_chart_set_type(ui_Chart2, LV_CHART_TYPE_LINE);
-    lv_obj_set_style_radius(ui_Chart2, 0, LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_bg_color(ui_Chart2, lv_color_hex(0x141414), LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_bg_opa(ui_Chart2, 255, LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_border_color(ui_Chart2, lv_color_hex(0x000000), LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_border_opa(ui_Chart2, 0, LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_line_color(ui_Chart2, lv_color_hex(0x4040FF), LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_line_opa(ui_Chart2, 0, LV_PART_MAIN | LV_STATE_DEFAULT);
 
     ui_Chart2_Xaxis = lv_scale_create(ui_Chart2);
     lv_scale_set_mode(ui_Chart2_Xaxis, LV_SCALE_MODE_HORIZONTAL_BOTTOM);
@@ -417,11 +458,6 @@ void ui_Screen1_screen_init(void)
     lv_obj_set_align(ui_Chart2_Xaxis, LV_ALIGN_BOTTOM_MID);
     lv_obj_set_y(ui_Chart2_Xaxis, 50 + lv_obj_get_style_pad_bottom(ui_Chart2,
                                                                    LV_PART_MAIN) + lv_obj_get_style_border_width(ui_Chart2, LV_PART_MAIN));
-    lv_obj_set_style_line_width(ui_Chart2_Xaxis, 0, LV_PART_MAIN);
-    lv_obj_set_style_line_width(ui_Chart2_Xaxis, 1, LV_PART_ITEMS);   //LVGL-9.1 ticks are thicker by default
-    lv_obj_set_style_line_width(ui_Chart2_Xaxis, 1, LV_PART_INDICATOR);
-    lv_obj_set_style_length(ui_Chart2_Xaxis, 5, LV_PART_ITEMS);      //minor tick length
-    lv_obj_set_style_length(ui_Chart2_Xaxis, 10, LV_PART_INDICATOR);      //major tick length
     lv_scale_set_range(ui_Chart2_Xaxis, 0, 5 > 0 ? 5 - 1 : 0);
     lv_scale_set_total_tick_count(ui_Chart2_Xaxis, (5 > 0 ? 5 - 1 : 0) * 2 + 1);
     lv_scale_set_major_tick_every(ui_Chart2_Xaxis, 2 >= 1 ? 2 : 1);
@@ -431,11 +467,6 @@ void ui_Screen1_screen_init(void)
     lv_obj_set_align(ui_Chart2_Yaxis1, LV_ALIGN_LEFT_MID);
     lv_obj_set_x(ui_Chart2_Yaxis1, -50 - lv_obj_get_style_pad_left(ui_Chart2,
                                                                    LV_PART_MAIN) - lv_obj_get_style_border_width(ui_Chart2, LV_PART_MAIN) + 2);
-    lv_obj_set_style_line_width(ui_Chart2_Yaxis1, 0, LV_PART_MAIN);
-    lv_obj_set_style_line_width(ui_Chart2_Yaxis1, 1, LV_PART_ITEMS);
-    lv_obj_set_style_line_width(ui_Chart2_Yaxis1, 1, LV_PART_INDICATOR);
-    lv_obj_set_style_length(ui_Chart2_Yaxis1, 5, LV_PART_ITEMS);   //minor tick length
-    lv_obj_set_style_length(ui_Chart2_Yaxis1, 10, LV_PART_INDICATOR);   //major tick length
     lv_scale_set_total_tick_count(ui_Chart2_Yaxis1, (5 > 0 ? 5 - 1 : 0) * 2 + 1);
     lv_scale_set_major_tick_every(ui_Chart2_Yaxis1, 2 >= 1 ? 2 : 1);
     ui_Chart2_Yaxis2 = lv_scale_create(ui_Chart2);
@@ -444,11 +475,6 @@ void ui_Screen1_screen_init(void)
     lv_obj_set_align(ui_Chart2_Yaxis2, LV_ALIGN_RIGHT_MID);
     lv_obj_set_x(ui_Chart2_Yaxis2, 25 + lv_obj_get_style_pad_right(ui_Chart2,
                                                                    LV_PART_MAIN) + lv_obj_get_style_border_width(ui_Chart2, LV_PART_MAIN) + 1);
-    lv_obj_set_style_line_width(ui_Chart2_Yaxis2, 0, LV_PART_MAIN);
-    lv_obj_set_style_line_width(ui_Chart2_Yaxis2, 1, LV_PART_ITEMS);
-    lv_obj_set_style_line_width(ui_Chart2_Yaxis2, 1, LV_PART_INDICATOR);
-    lv_obj_set_style_length(ui_Chart2_Yaxis2, 5, LV_PART_ITEMS);   //minor tick length
-    lv_obj_set_style_length(ui_Chart2_Yaxis2, 10, LV_PART_INDICATOR);   //major tick length
     lv_scale_set_total_tick_count(ui_Chart2_Yaxis2, (5 > 0 ? 5 - 1 : 0) * 2 + 1);
     lv_scale_set_major_tick_every(ui_Chart2_Yaxis2, 2 >= 1 ? 2 : 1);
     lv_chart_series_t * ui_Chart2_series_1 = lv_chart_add_series(ui_Chart2, lv_color_hex(0xD0A510),
@@ -456,33 +482,8 @@ void ui_Screen1_screen_init(void)
     static lv_coord_t ui_Chart2_series_1_array[] = { 0, 10, 20, 40, 80, 80, 40, 20, 10, 0 };
     lv_chart_set_ext_y_array(ui_Chart2, ui_Chart2_series_1, ui_Chart2_series_1_array);
 
-    lv_obj_set_style_line_width(ui_Chart2, 2, LV_PART_ITEMS | LV_STATE_DEFAULT);
-
-    lv_obj_set_style_size(ui_Chart2, 0, 0, LV_PART_INDICATOR | LV_STATE_DEFAULT);
-
-    lv_obj_set_style_line_color(ui_Chart2_Xaxis, lv_color_hex(0x4040FF), LV_PART_INDICATOR | LV_STATE_DEFAULT);
-    lv_obj_set_style_line_opa(ui_Chart2_Xaxis, 0, LV_PART_INDICATOR | LV_STATE_DEFAULT);
-    lv_obj_set_style_line_color(ui_Chart2_Yaxis1, lv_color_hex(0x4040FF), LV_PART_INDICATOR | LV_STATE_DEFAULT);
-    lv_obj_set_style_line_opa(ui_Chart2_Yaxis1, 0, LV_PART_INDICATOR | LV_STATE_DEFAULT);
-    lv_obj_set_style_line_color(ui_Chart2_Yaxis2, lv_color_hex(0x4040FF), LV_PART_INDICATOR | LV_STATE_DEFAULT);
-    lv_obj_set_style_line_opa(ui_Chart2_Yaxis2, 0, LV_PART_INDICATOR | LV_STATE_DEFAULT);
-    lv_obj_set_style_line_color(ui_Chart2_Xaxis, lv_color_hex(0x4040FF), LV_PART_ITEMS | LV_STATE_DEFAULT);
-    lv_obj_set_style_line_opa(ui_Chart2_Xaxis, 0, LV_PART_ITEMS | LV_STATE_DEFAULT);
-    lv_obj_set_style_line_color(ui_Chart2_Yaxis1, lv_color_hex(0x4040FF), LV_PART_ITEMS | LV_STATE_DEFAULT);
-    lv_obj_set_style_line_opa(ui_Chart2_Yaxis1, 0, LV_PART_ITEMS | LV_STATE_DEFAULT);
-    lv_obj_set_style_line_color(ui_Chart2_Yaxis2, lv_color_hex(0x4040FF), LV_PART_ITEMS | LV_STATE_DEFAULT);
-    lv_obj_set_style_line_opa(ui_Chart2_Yaxis2, 0, LV_PART_ITEMS | LV_STATE_DEFAULT);
-    lv_obj_set_style_text_color(ui_Chart2_Xaxis, lv_color_hex(0xFFFFFF), LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_text_opa(ui_Chart2_Xaxis, 0, LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_text_color(ui_Chart2_Yaxis1, lv_color_hex(0xFFFFFF), LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_text_opa(ui_Chart2_Yaxis1, 0, LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_text_color(ui_Chart2_Yaxis2, lv_color_hex(0xFFFFFF), LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_text_opa(ui_Chart2_Yaxis2, 0, LV_PART_MAIN | LV_STATE_DEFAULT);
+    chart_add_styles(ui_Chart2, ui_Chart2_Xaxis, ui_Chart2_Yaxis1, ui_Chart2_Yaxis2);
 
-    //This workaround (an invisible outline) is needed because without it chart overflow-visible doesn't work in LVGL-9.1
-    lv_obj_set_style_outline_pad(ui_Chart2, LV_MAX3(50, 50, 25),
-                                 LV_PART_MAIN | LV_STATE_DEFAULT);   //workaround for ineffective 'overflow visible' flag
-    lv_obj_set_style_outline_width(ui_Chart2, -1, LV_PART_MAIN | LV_STATE_DEFAULT);
     ui_Label5 = lv_label_create(ui_Chart2);
     lv_obj_set_width(ui_Label5, LV_SIZE_CONTENT);   /// 1
     lv_obj_set_height(ui_Label5, LV_SIZE_CONTENT);    /// 1
@@ -490,8 +491,7 @@ void ui_Screen1_screen_init(void)
     lv_obj_set_y(ui_Label5, -35);
     lv_obj_set_align(ui_Label5, LV_ALIGN_CENTER);
     lv_label_set_text(ui_Label5, "45W");
-    lv_obj_set_style_text_color(ui_Label5, lv_color_hex(0xFFFFFF), LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_text_opa(ui_Label5, 255, LV_PART_MAIN | LV_STATE_DEFAULT);
+    lv_obj_add_style(ui_Label5, &style_readout, LV_PART_MAIN | LV_STATE_DEFAULT);
 
     ui_Label6 = lv_label_create(ui_Panel4);
     lv_obj_set_width(ui_Label6, LV_SIZE_CONTENT);   /// 1
@@ -500,8 +500,7 @@ void ui_Screen1_screen_init(void)
     lv_obj_set_y(ui_Label6, 5);
     lv_obj_set_align(ui_Label6, LV_ALIGN_CENTER);
     lv_label_set_text(ui_Label6, "POWER");
-    lv_obj_set_style_text_color(ui_Label6, lv_color_hex(0xFFFFFF), LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_text_opa(ui_Label6, 255, LV_PART_MAIN | LV_STATE_DEFAULT);
+    lv_obj_add_style(ui_Label6, &style_readout, LV_PART_MAIN | LV_STATE_DEFAULT);
 
     ui_Panel6 = lv_obj_create(ui_Screen1);
     lv_obj_set_width(ui_Panel6, 365);
@@ -510,15 +509,8 @@ void ui_Screen1_screen_init(void)
     lv_obj_set_y(ui_Panel6, -129);
     lv_obj_set_align(ui_Panel6, LV_ALIGN_CENTER);
     lv_obj_remove_flag(ui_Panel6, LV_OBJ_FLAG_SCROLLABLE);      /// Flags
-    lv_obj_set_style_radius(ui_Panel6, 0, LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_bg_color(ui_Panel6, lv_color_hex(0x2B2B2B), LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_bg_opa(ui_Panel6, 255, LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_border_color(ui_Panel6, lv_color_hex(0x000000), LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_border_opa(ui_Panel6, 0, LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_outline_color(ui_Panel6, lv_color_hex(0x000000), LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_outline_opa(ui_Panel6, 0, LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_outline_width(ui_Panel6, 1, LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_outline_pad(ui_Panel6, 0, LV_PART_MAIN | LV_STATE_DEFAULT);
+    lv_obj_add_style(ui_Panel6, &style_panel, LV_PART_MAIN | LV_STATE_DEFAULT);
+    lv_obj_add_style(ui_Panel6, &style_panel_light, LV_PART_MAIN | LV_STATE_DEFAULT);
 
     ui_Label8 = lv_label_create(ui_Panel6);
     lv_obj_set_width(ui_Label8, LV_SIZE_CONTENT);   /// 1
@@ -527,8 +519,7 @@ void ui_Screen1_screen_init(void)
     lv_obj_set_y(ui_Label8, 5);
     lv_obj_set_align(ui_Label8, LV_ALIGN_CENTER);
     lv_label_set_text(ui_Label8, "VOLTAGE");
-    lv_obj_set_style_text_color(ui_Label8, lv_color_hex(0xFFFFFF), LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_text_opa(ui_Label8, 255, LV_PART_MAIN | LV_STATE_DEFAULT);
+    lv_obj_add_style(ui_Label8, &style_readout, LV_PART_MAIN | LV_STATE_DEFAULT);
 
     ui_Spinbox1 = lv_spinbox_create(ui_Panel6);
     lv_obj_set_width(ui_Spinbox1, 120);
@@ -539,15 +530,8 @@ void ui_Screen1_screen_init(void)
     lv_spinbox_set_digit_format(ui_Spinbox1, 4, 2);
     lv_spinbox_set_range(ui_Spinbox1, 0, 2000);
     lv_spinbox_set_cursor_pos(ui_Spinbox1, 1 - 1);
-    lv_obj_set_style_radius(ui_Spinbox1, 0, LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_bg_color(ui_Spinbox1, lv_color_hex(0x2B2B2B), LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_bg_opa(ui_Spinbox1, 255, LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_border_color(ui_Spinbox1, lv_color_hex(0x000000), LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_border_opa(ui_Spinbox1, 0, LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_text_color(ui_Spinbox1, lv_color_hex(0x808080), LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_text_opa(ui_Spinbox1, 255, LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_text_align(ui_Spinbox1, LV_TEXT_ALIGN_CENTER, LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_text_font(ui_Spinbox1, &lv_font_montserrat_20, LV_PART_MAIN | LV_STATE_DEFAULT);
+    lv_obj_add_style(ui_Spinbox1, &style_spinbox, LV_PART_MAIN | LV_STATE_DEFAULT);
+    lv_obj_add_style(ui_Spinbox1, &style_text_center, LV_PART_MAIN | LV_STATE_DEFAULT);
 
     ui_Button2 = lv_button_create(ui_Panel6);
     lv_obj_set_width(ui_Button2, 40);
@@ -557,9 +541,7 @@ void ui_Screen1_screen_init(void)
     lv_obj_set_align(ui_Button2, LV_ALIGN_CENTER);
     lv_obj_add_flag(ui_Button2, LV_OBJ_FLAG_SCROLL_ON_FOCUS);     /// Flags
     lv_obj_remove_flag(ui_Button2, LV_OBJ_FLAG_SCROLLABLE);      /// Flags
-    lv_obj_set_style_radius(ui_Button2, 0, LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_bg_color(ui_Button2, lv_color_hex(0x2B2B2B), LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_bg_opa(ui_Button2, 255, LV_PART_MAIN | LV_STATE_DEFAULT);
+    lv_obj_add_style(ui_Button2, &style_button, LV_PART_MAIN | LV_STATE_DEFAULT);
 
     ui_Button3 = lv_button_create(ui_Panel6);
     lv_obj_set_width(ui_Button3, 40);
@@ -569,9 +551,7 @@ void ui_Screen1_screen_init(void)
     lv_obj_set_align(ui_Button3, LV_ALIGN_CENTER);
     lv_obj_add_flag(ui_Button3, LV_OBJ_FLAG_SCROLL_ON_FOCUS);     /// Flags
     lv_obj_remove_flag(ui_Button3, LV_OBJ_FLAG_SCROLLABLE);      /// Flags
-    lv_obj_set_style_radius(ui_Button3, 0, LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_bg_color(ui_Button3, lv_color_hex(0x2B2B2B), LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_bg_opa(ui_Button3, 255, LV_PART_MAIN | LV_STATE_DEFAULT);
+    lv_obj_add_style(ui_Button3, &style_button, LV_PART_MAIN | LV_STATE_DEFAULT);
 
     ui_Panel7 = lv_obj_create(ui_Screen1);
     lv_obj_set_width(ui_Panel7, 364);
@@ -580,15 +560,8 @@ void ui_Screen1_screen_init(void)
     lv_obj_set_y(ui_Panel7, -25);
     lv_obj_set_align(ui_Panel7, LV_ALIGN_CENTER);
     lv_obj_remove_flag(ui_Panel7, LV_OBJ_FLAG_SCROLLABLE);      /// Flags
-    lv_obj_set_style_radius(ui_Panel7, 0, LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_bg_color(ui_Panel7, lv_color_hex(0x2B2B2B), LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_bg_opa(ui_Panel7, 255, LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_border_color(ui_Panel7, lv_color_hex(0x000000), LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_border_opa(ui_Panel7, 0, LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_outline_color(ui_Panel7, lv_color_hex(0x000000), LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_outline_opa(ui_Panel7, 0, LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_outline_width(ui_Panel7, 1, LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_outline_pad(ui_Panel7, 0, LV_PART_MAIN | LV_STATE_DEFAULT);
+    lv_obj_add_style(ui_Panel7, &style_panel, LV_PART_MAIN | LV_STATE_DEFAULT);
+    lv_obj_add_style(ui_Panel7, &style_panel_light, LV_PART_MAIN | LV_STATE_DEFAULT);
 
     ui_Label10 = lv_label_create(ui_Panel7);
     lv_obj_set_width(ui_Label10, LV_SIZE_CONTENT);   /// 1
@@ -597,8 +570,7 @@ void ui_Screen1_screen_init(void)
     lv_obj_set_y(ui_Label10, 5);
     lv_obj_set_align(ui_Label10, LV_ALIGN_CENTER);
     lv_label_set_text(ui_Label10, "AMPER");
-    lv_obj_set_style_text_color(ui_Label10, lv_color_hex(0xFFFFFF), LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_text_opa(ui_Label10, 255, LV_PART_MAIN | LV_STATE_DEFAULT);
+    lv_obj_add_style(ui_Label10, &style_readout, LV_PART_MAIN | LV_STATE_DEFAULT);
 
     ui_Spinbox2 = lv_spinbox_create(ui_Panel7);
     lv_obj_set_width(ui_Spinbox2, 70);
@@ -609,14 +581,7 @@ void ui_Screen1_screen_init(void)
     lv_spinbox_set_digit_format(ui_Spinbox2, 4, 2);
     lv_spinbox_set_range(ui_Spinbox2, 0, 500);
     lv_spinbox_set_cursor_pos(ui_Spinbox2, 1 - 1);
-    lv_obj_set_style_radius(ui_Spinbox2, 0, LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_bg_color(ui_Spinbox2, lv_color_hex(0x2B2B2B), LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_bg_opa(ui_Spinbox2, 255, LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_border_color(ui_Spinbox2, lv_color_hex(0x000000), LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_border_opa(ui_Spinbox2, 0, LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_text_color(ui_Spinbox2, lv_color_hex(0x808080), LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_text_opa(ui_Spinbox2, 255, LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_text_font(ui_Spinbox2, &lv_font_montserrat_20, LV_PART_MAIN | LV_STATE_DEFAULT);
+    lv_obj_add_style(ui_Spinbox2, &style_spinbox, LV_PART_MAIN | LV_STATE_DEFAULT);
 
     ui_Button4 = lv_button_create(ui_Panel7);
     lv_obj_set_width(ui_Button4, 40);
@@ -626,9 +591,7 @@ void ui_Screen1_screen_init(void)
     lv_obj_set_align(ui_Button4, LV_ALIGN_CENTER);
     lv_obj_add_flag(ui_Button4, LV_OBJ_FLAG_SCROLL_ON_FOCUS);     /// Flags
     lv_obj_remove_flag(ui_Button4, LV_OBJ_FLAG_SCROLLABLE);      /// Flags
-    lv_obj_set_style_radius(ui_Button4, 0, LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_bg_color(ui_Button4, lv_color_hex(0x2B2B2B), LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_bg_opa(ui_Button4, 255, LV_PART_MAIN | LV_STATE_DEFAULT);
+    lv_obj_add_style(ui_Button4, &style_button, LV_PART_MAIN | LV_STATE_DEFAULT);
 
     ui_Button5 = lv_button_create(ui_Panel7);
     lv_obj_set_width(ui_Button5, 40);
@@ -638,9 +601,7 @@ void ui_Screen1_screen_init(void)
     lv_obj_set_align(ui_Button5, LV_ALIGN_CENTER);
     lv_obj_add_flag(ui_Button5, LV_OBJ_FLAG_SCROLL_ON_FOCUS);     /// Flags
     lv_obj_remove_flag(ui_Button5, LV_OBJ_FLAG_SCROLLABLE);      /// Flags
-    lv_obj_set_style_radius(ui_Button5, 0, LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_bg_color(ui_Button5, lv_color_hex(0x2B2B2B), LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_bg_opa(ui_Button5, 255, LV_PART_MAIN | LV_STATE_DEFAULT);
+    lv_obj_add_style(ui_Button5, &style_button, LV_PART_MAIN | LV_STATE_DEFAULT);
 
     lv_obj_add_event_cb(ui_Button2, ui_event_Button2, LV_EVENT_ALL, NULL);
     lv_obj_add_event_cb(ui_Button3, ui_event_Button3, LV_EVENT_ALL, NULL);
@@ -59,8 +59,8 @@ lv_obj_t * ui____initial_actions0;
 // IMAGES AND IMAGE SETS
 
 ///////////////////// TEST LVGL SETTINGS ////////////////////
-#if LV_COLOR_DEPTH != 32
-    #error "LV_COLOR_DEPTH should be 32bit to match SquareLine Studio's settings"
+#if LV_COLOR_DEPTH != 16 && LV_COLOR_DEPTH != 32
+    #error "LV_COLOR_DEPTH should be 16bit (RGB565) or 32bit, the custom drawing supports only these"
 #endif
 
 ///////////////////// ANIMATIONS ////////////////////
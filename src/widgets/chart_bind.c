@@ -0,0 +1,109 @@
+/**
+ * @file chart_bind.c
+ *
+ * Chart series bound to a telemetry ring
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "chart_bind.h"
+#include "lvgl/src/widgets/chart/lv_chart_private.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void invalidate_plot(lv_obj_t *chart);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void chart_bind_init(chart_bind_t *bind, lv_obj_t *chart, lv_chart_series_t *ser,
+                     const telemetry_ring_t *ring)
+{
+    uint32_t point_cnt = lv_chart_get_point_count(chart);
+
+    if (point_cnt > TELEMETRY_WINDOW_MAX) {
+        point_cnt = TELEMETRY_WINDOW_MAX;
+        lv_chart_set_point_count(chart, point_cnt);
+    }
+
+    bind->chart = chart;
+    bind->ser = ser;
+    bind->ring = ring;
+    bind->point_cnt = point_cnt;
+    bind->shown = ring->count;
+
+    /* The window is oldest first, the chart must not rotate it */
+    lv_chart_set_update_mode(chart, LV_CHART_UPDATE_MODE_SHIFT);
+    lv_chart_set_x_start_point(chart, ser, 0);
+    lv_chart_set_ext_y_array(chart, ser, (int32_t *)telemetry_ring_window(ring, point_cnt));
+}
+
+bool chart_bind_refresh(chart_bind_t *binds, uint32_t cnt)
+{
+    lv_obj_t *invalid = NULL;
+    bool refreshed = false;
+    chart_bind_t *bind;
+    uint32_t i;
+
+    for (i = 0; i < cnt; i++) {
+        bind = &binds[i];
+        if (bind->ring->count == bind->shown) {
+            continue;
+        }
+
+        /*
+         * Repoint the external array in place: lv_chart_set_ext_y_array
+         * would invalidate the whole object, scales included
+         */
+        bind->ser->y_points = (int32_t *)telemetry_ring_window(bind->ring, bind->point_cnt);
+        bind->shown = bind->ring->count;
+
+        /* Series of the same chart are next to each other */
+        if (bind->chart != invalid) {
+            invalidate_plot(bind->chart);
+            invalid = bind->chart;
+            refreshed = true;
+        }
+    }
+
+    return refreshed;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Invalidate the area the series are drawn in
+ *
+ * @description every point moves when the window moves, so the whole
+ * plot is redrawn, but not the axes hanging outside of it
+ * @param chart the chart
+ */
+static void invalidate_plot(lv_obj_t *chart)
+{
+    lv_area_t area;
+
+    lv_obj_get_coords(chart, &area);
+    lv_obj_invalidate_area(chart, &area);
+}
@@ -0,0 +1,83 @@
+/**
+ * @file chart_bind.h
+ *
+ * Chart series bound to a telemetry ring
+ *
+ * The series reads its points straight from the latest window of a
+ * telemetry ring: appending a sample copies or shifts nothing, the
+ * series is only pointed at the window that now ends one sample later.
+ * Updates are applied once per refresh, whatever the number of samples
+ * that arrived in between.
+ *
+ */
+
+#ifndef CHART_BIND_H
+#define CHART_BIND_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "lvgl/lvgl.h"
+#include "../dps150/telemetry.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+typedef struct {
+    lv_obj_t *chart;
+    lv_chart_series_t *ser;
+    const telemetry_ring_t *ring;
+    uint32_t point_cnt;
+    uint64_t shown;             /* Ring count when the window was last moved */
+} chart_bind_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Bind a series to a ring
+ *
+ * @description the chart keeps its point count, up to
+ * TELEMETRY_WINDOW_MAX. Its values are read in the ring's milli-units,
+ * so the chart range has to be set in milli-units too
+ * @param bind the binding to initialize
+ * @param chart the chart
+ * @param ser a series of the chart
+ * @param ring the ring, it must outlive the binding
+ */
+void chart_bind_init(chart_bind_t *bind, lv_obj_t *chart, lv_chart_series_t *ser,
+                     const telemetry_ring_t *ring);
+
+/**
+ * Move the windows of the series whose ring got new samples
+ *
+ * @description each chart with a moved series has its plot area
+ * invalidated once. The axes outside the plot are left alone
+ * @param binds the bindings, those of one chart next to each other
+ * @param cnt number of bindings
+ * @return true if at least one chart was invalidated
+ */
+bool chart_bind_refresh(chart_bind_t *binds, uint32_t cnt);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*CHART_BIND_H*/
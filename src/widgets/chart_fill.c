@@ -0,0 +1,247 @@
+/**
+ * @file chart_fill.c
+ *
+ * Gradient area fill under the series of an lv_chart
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include <string.h>
+
+#include "chart_fill.h"
+#include "fill_mix.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/* FNV-1a */
+#define HASH_INIT 2166136261u
+#define HASH_PRIME 16777619u
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void draw_main_end_cb(lv_event_t *e);
+static void rebuild(chart_fill_t *fill, chart_fill_series_t *fs, const int32_t *top);
+static void rebuild_argb8888(chart_fill_t *fill, chart_fill_series_t *fs, const int32_t *top);
+static void rebuild_rgb565a8(chart_fill_t *fill, chart_fill_series_t *fs, const int32_t *top);
+static uint32_t series_top(chart_fill_t *fill, chart_fill_series_t *fs, int32_t *top);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+int chart_fill_attach(chart_fill_t *fill, lv_obj_t *chart, const lv_opa_t *max_opa)
+{
+    chart_fill_series_t *fs;
+    lv_chart_series_t *ser = NULL;
+
+    memset(fill, 0, sizeof(*fill));
+    fill->chart = chart;
+
+    /* Coordinates are computed lazily, the chart may still have the
+     * size it was created with */
+    lv_obj_update_layout(chart);
+
+    fill->cf = lv_display_get_color_format(lv_obj_get_display(chart)) == LV_COLOR_FORMAT_RGB565 ?
+               LV_COLOR_FORMAT_RGB565A8 : LV_COLOR_FORMAT_ARGB8888;
+    fill->w = LV_MIN(lv_obj_get_width(chart), CHART_FILL_WIDTH_MAX);
+    fill->h = LV_MIN(lv_obj_get_height(chart), CHART_FILL_HEIGHT_MAX);
+
+    while (fill->series_cnt < CHART_FILL_SERIES_MAX &&
+           (ser = lv_chart_get_series_next(chart, ser)) != NULL) {
+        fs = &fill->series[fill->series_cnt];
+        fs->ser = ser;
+        fs->buf = lv_draw_buf_create(fill->w, fill->h, fill->cf, 0);
+        if (fs->buf == NULL) {
+            return -1;
+        }
+        fs->rgb = UINT32_MAX;
+
+        /* Same fade as a vertical gradient over the whole chart height */
+        fill_mix_gradient_ramp(fs->ramp, fill->h, max_opa[fill->series_cnt]);
+
+        fill->series_cnt++;
+    }
+
+    lv_obj_add_event_cb(chart, draw_main_end_cb, LV_EVENT_DRAW_MAIN_END, fill);
+    return 0;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Draw the cached fills, rebuilding those whose series changed
+ * @param e the draw event of the chart
+ */
+static void draw_main_end_cb(lv_event_t *e)
+{
+    chart_fill_t *fill = lv_event_get_user_data(e);
+    lv_layer_t *layer = lv_event_get_layer(e);
+    int32_t top[CHART_FILL_WIDTH_MAX];
+    lv_draw_image_dsc_t dsc;
+    chart_fill_series_t *fs;
+    lv_area_t coords;
+    uint32_t hash;
+    uint32_t i;
+
+    lv_obj_get_coords(fill->chart, &coords);
+    coords.x2 = coords.x1 + fill->w - 1;
+    coords.y2 = coords.y1 + fill->h - 1;
+
+    for (i = 0; i < fill->series_cnt; i++) {
+        fs = &fill->series[i];
+
+        hash = series_top(fill, fs, top);
+        if (hash != fs->hash) {
+            rebuild(fill, fs, top);
+            fs->hash = hash;
+        }
+
+        lv_draw_image_dsc_init(&dsc);
+        dsc.src = fs->buf;
+        lv_draw_image(layer, &dsc, &coords);
+    }
+}
+
+/**
+ * Find the top row of the area in every column
+ *
+ * @description the polyline is interpolated between the chart's own
+ * point positions, columns outside it or next to a missing point get
+ * the chart height
+ * @param fill the fill state
+ * @param fs the series
+ * @param top receives one row per column
+ * @return a hash of the columns, to tell whether the image is stale
+ */
+static uint32_t series_top(chart_fill_t *fill, chart_fill_series_t *fs, int32_t *top)
+{
+    const int32_t *values = lv_chart_get_y_array(fill->chart, fs->ser);
+    uint32_t cnt = lv_chart_get_point_count(fill->chart);
+    uint32_t hash = HASH_INIT;
+    lv_point_t p0;
+    lv_point_t p1;
+    int32_t x;
+    uint32_t i;
+
+    for (x = 0; x < fill->w; x++) {
+        top[x] = fill->h;
+    }
+
+    for (i = 1; i < cnt; i++) {
+        if (values[i - 1] == LV_CHART_POINT_NONE || values[i] == LV_CHART_POINT_NONE) {
+            continue;
+        }
+
+        /* Positions relative to the chart, like the line draw tasks */
+        lv_chart_get_point_pos_by_id(fill->chart, fs->ser, i - 1, &p0);
+        lv_chart_get_point_pos_by_id(fill->chart, fs->ser, i, &p1);
+
+        for (x = LV_MAX(p0.x, 0); x <= p1.x && x < fill->w; x++) {
+            top[x] = p1.x == p0.x ? LV_MIN(p0.y, p1.y) :
+                     p0.y + (p1.y - p0.y) * (x - p0.x) / (p1.x - p0.x);
+            top[x] = LV_CLAMP(0, top[x], fill->h);
+        }
+    }
+
+    for (x = 0; x < fill->w; x++) {
+        hash = (hash ^ (uint32_t)top[x]) * HASH_PRIME;
+    }
+
+    return hash;
+}
+
+/**
+ * Rasterise the area under a series in one pass over the rows
+ * @param fill the fill state
+ * @param fs the series
+ * @param top the top row of every column
+ */
+static void rebuild(chart_fill_t *fill, chart_fill_series_t *fs, const int32_t *top)
+{
+    if (fill->cf == LV_COLOR_FORMAT_RGB565A8) {
+        rebuild_rgb565a8(fill, fs, top);
+    } else {
+        rebuild_argb8888(fill, fs, top);
+    }
+
+    /* The draw buffer is the image source, drop what was cached from it */
+    lv_image_cache_drop(fs->buf);
+}
+
+/**
+ * Rasterise into an ARGB8888 image, color and opacity in every pixel
+ * @param fill the fill state
+ * @param fs the series
+ * @param top the top row of every column
+ */
+static void rebuild_argb8888(chart_fill_t *fill, chart_fill_series_t *fs, const int32_t *top)
+{
+    uint32_t rgb = lv_color_to_u32(lv_chart_get_series_color(fill->chart, fs->ser)) & 0xFFFFFFu;
+    uint32_t stride = fs->buf->header.stride;
+    uint32_t px;
+    uint32_t *row;
+    int32_t x;
+    int32_t y;
+
+    for (y = 0; y < fill->h; y++) {
+        row = (uint32_t *)(fs->buf->data + (uint32_t)y * stride);
+        px = ((uint32_t)fs->ramp[y] << 24) | rgb;
+
+        for (x = 0; x < fill->w; x++) {
+            row[x] = y >= top[x] ? px : 0;
+        }
+    }
+}
+
+/**
+ * Rasterise into an RGB565A8 image
+ *
+ * @description the RGB565 plane is followed by the opacity plane, with
+ * half its stride. The color plane is only written when the series
+ * color changed
+ * @param fill the fill state
+ * @param fs the series
+ * @param top the top row of every column
+ */
+static void rebuild_rgb565a8(chart_fill_t *fill, chart_fill_series_t *fs, const int32_t *top)
+{
+    lv_color_t color = lv_chart_get_series_color(fill->chart, fs->ser);
+    uint32_t rgb = lv_color_to_u32(color) & 0xFFFFFFu;
+    uint32_t stride = fs->buf->header.stride;
+    uint8_t *alpha = fs->buf->data + stride * (uint32_t)fill->h;
+    uint16_t px = lv_color_to_u16(color);
+    uint16_t *row;
+    int32_t x;
+    int32_t y;
+
+    if (rgb != fs->rgb) {
+        for (y = 0; y < fill->h; y++) {
+            row = (uint16_t *)(fs->buf->data + (uint32_t)y * stride);
+            for (x = 0; x < fill->w; x++) {
+                row[x] = px;
+            }
+        }
+        fs->rgb = rgb;
+    }
+
+    fill_mix_opa_plane(alpha, stride / 2, fill->w, fill->h, fs->ramp, top);
+}
@@ -0,0 +1,87 @@
+/**
+ * @file chart_fill.h
+ *
+ * Gradient area fill under the series of an lv_chart
+ *
+ * The area under each series' polyline is rasterised in one scanline
+ * pass into an ARGB8888 image, the opacity of each row read from a
+ * precomputed vertical ramp. The image is kept and only rebuilt when
+ * the series values change, and drawn as a single image per series
+ * after the chart's main part.
+ *
+ * On 16-bit displays the image is RGB565A8: its color plane holds the
+ * series color and is written once, a rebuild only writes the 8-bit
+ * opacity plane.
+ *
+ */
+
+#ifndef CHART_FILL_H
+#define CHART_FILL_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include <stdint.h>
+
+#include "lvgl/lvgl.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+#define CHART_FILL_SERIES_MAX 2
+
+/* Largest chart filled, taller ones are cut */
+#define CHART_FILL_WIDTH_MAX 1024
+#define CHART_FILL_HEIGHT_MAX 256
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+typedef struct {
+    lv_chart_series_t *ser;
+    lv_draw_buf_t *buf;
+    uint32_t hash;                          /* Values and positions the image was built from */
+    uint32_t rgb;                           /* Series color in the RGB565A8 color plane */
+    uint8_t ramp[CHART_FILL_HEIGHT_MAX];    /* Opacity of each row */
+} chart_fill_series_t;
+
+typedef struct {
+    lv_obj_t *chart;
+    lv_color_format_t cf;                   /* ARGB8888 or RGB565A8 */
+    int32_t w;
+    int32_t h;
+    chart_fill_series_t series[CHART_FILL_SERIES_MAX];
+    uint32_t series_cnt;
+} chart_fill_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Fill the area under the series of a chart
+ *
+ * @description the first series fades from max_opa[0] at the top of
+ * the chart to 0 at the bottom, the second one from max_opa[1]
+ * @param fill the fill state, it must outlive the chart
+ * @param chart the chart, its series must exist already
+ * @param max_opa the opacity at the top of the chart of each series
+ * @return 0 on success, -1 if a buffer cannot be allocated
+ */
+int chart_fill_attach(chart_fill_t *fill, lv_obj_t *chart, const lv_opa_t *max_opa);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*CHART_FILL_H*/
@@ -0,0 +1,159 @@
+/**
+ * @file draw_bench.c
+ *
+ * Full screen redraw benchmark
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "draw_bench.h"
+#include "../lib/simulator_util.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void refr_event_cb(lv_event_t *e);
+static void finish(draw_bench_t *bench);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void draw_bench_start(draw_bench_t *bench, lv_display_t *disp, uint32_t frames,
+                      draw_bench_done_cb_t done_cb, void *user_data)
+{
+    lv_timer_t *refr_timer = lv_display_get_refr_timer(disp);
+
+    lv_memzero(bench, sizeof(*bench));
+    bench->disp = disp;
+    bench->frames = frames;
+    bench->done_cb = done_cb;
+    bench->user_data = user_data;
+    bench->min_us = UINT32_MAX;
+
+    /* Refresh as soon as the previous frame is out */
+    if (refr_timer != NULL) {
+        lv_timer_set_period(refr_timer, 1);
+    }
+
+    lv_display_add_event_cb(disp, refr_event_cb, LV_EVENT_REFR_START, bench);
+    lv_display_add_event_cb(disp, refr_event_cb, LV_EVENT_FLUSH_FINISH, bench);
+    lv_display_add_event_cb(disp, refr_event_cb, LV_EVENT_REFR_READY, bench);
+
+    lv_obj_invalidate(lv_display_get_screen_active(disp));
+}
+
+void draw_bench_print(FILE *out, const draw_bench_t *bench)
+{
+    uint32_t measured = bench->rendered > DRAW_BENCH_WARMUP ?
+                        bench->rendered - DRAW_BENCH_WARMUP : 0;
+
+    if (measured == 0) {
+        fprintf(out, "draw bench: no frame measured\n");
+        return;
+    }
+
+    fprintf(out, "draw bench: %d draw units, %dx%d, %u bpp, %u frames\n",
+            LV_DRAW_SW_DRAW_UNIT_CNT,
+            (int)lv_display_get_horizontal_resolution(bench->disp),
+            (int)lv_display_get_vertical_resolution(bench->disp),
+            (unsigned)lv_color_format_get_bpp(lv_display_get_color_format(bench->disp)),
+            measured);
+    fprintf(out, "draw bench: frame %.2f ms average, %.2f ms min, %.2f ms max, %.1f frames/s\n",
+            (double)bench->total_us / measured / 1000.0,
+            (double)bench->min_us / 1000.0,
+            (double)bench->max_us / 1000.0,
+            measured * 1000000.0 / (double)(bench->last_us - bench->first_us));
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Measure a refresh and invalidate the screen again
+ *
+ * @description refreshes that flushed nothing, e.g. before the screen
+ * is loaded, are not counted
+ * @param e LV_EVENT_REFR_START, LV_EVENT_FLUSH_FINISH or
+ * LV_EVENT_REFR_READY of the display
+ */
+static void refr_event_cb(lv_event_t *e)
+{
+    draw_bench_t *bench = lv_event_get_user_data(e);
+    lv_event_code_t code = lv_event_get_code(e);
+    uint64_t now = get_monotonic_us();
+    uint32_t elapsed;
+
+    if (code == LV_EVENT_REFR_START) {
+        bench->refr_start_us = now;
+        bench->flushed = false;
+        return;
+    }
+
+    if (code == LV_EVENT_FLUSH_FINISH) {
+        bench->flushed = true;
+        return;
+    }
+
+    if (!bench->flushed) {
+        return;
+    }
+
+    bench->rendered++;
+    if (bench->rendered > DRAW_BENCH_WARMUP) {
+        elapsed = (uint32_t)(now - bench->refr_start_us);
+
+        if (bench->rendered == DRAW_BENCH_WARMUP + 1) {
+            bench->first_us = bench->refr_start_us;
+        }
+        bench->last_us = now;
+        bench->total_us += elapsed;
+        bench->min_us = LV_MIN(bench->min_us, elapsed);
+        bench->max_us = LV_MAX(bench->max_us, elapsed);
+
+        if (bench->rendered - DRAW_BENCH_WARMUP >= bench->frames) {
+            finish(bench);
+            return;
+        }
+    }
+
+    lv_obj_invalidate(lv_display_get_screen_active(bench->disp));
+}
+
+/**
+ * Stop the benchmark and restore the refresh period
+ * @param bench the benchmark
+ */
+static void finish(draw_bench_t *bench)
+{
+    lv_timer_t *refr_timer = lv_display_get_refr_timer(bench->disp);
+
+    lv_display_remove_event_cb_with_user_data(bench->disp, refr_event_cb, bench);
+
+    if (refr_timer != NULL) {
+        lv_timer_set_period(refr_timer, LV_DEF_REFR_PERIOD);
+    }
+
+    if (bench->done_cb != NULL) {
+        bench->done_cb(bench->user_data);
+    }
+}
@@ -0,0 +1,91 @@
+/**
+ * @file draw_bench.h
+ *
+ * Full screen redraw benchmark
+ *
+ * Invalidates the whole active screen after every refresh and measures
+ * each refresh, from its start until the last area is flushed. The
+ * display refreshes as fast as it can during the benchmark, then goes
+ * back to LV_DEF_REFR_PERIOD. The first frames warm the image and glyph
+ * caches up and are not counted.
+ *
+ * Run it once per number of software draw units to see how rendering
+ * scales with them, see scripts/bench_draw_units.sh.
+ *
+ */
+
+#ifndef DRAW_BENCH_H
+#define DRAW_BENCH_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "lvgl/lvgl.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/* Frames rendered before the measurement starts */
+#define DRAW_BENCH_WARMUP 10
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+typedef void (*draw_bench_done_cb_t)(void *user_data);
+
+typedef struct {
+    lv_display_t *disp;
+    draw_bench_done_cb_t done_cb;
+    void *user_data;
+    uint32_t frames;            /* Frames to measure */
+    uint32_t rendered;          /* Frames rendered, warmup included */
+    bool flushed;               /* The current refresh flushed something */
+    uint64_t refr_start_us;
+    uint64_t first_us;          /* Start of the first measured frame */
+    uint64_t last_us;           /* End of the last measured frame */
+    uint64_t total_us;          /* Sum of the measured frames */
+    uint32_t min_us;
+    uint32_t max_us;
+} draw_bench_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Start redrawing the screen of a display
+ * @param bench the benchmark to initialize, it must stay valid until done
+ * @param disp the display
+ * @param frames the number of frames to measure
+ * @param done_cb called once the frames are measured, may be NULL
+ * @param user_data passed to done_cb
+ */
+void draw_bench_start(draw_bench_t *bench, lv_display_t *disp, uint32_t frames,
+                      draw_bench_done_cb_t done_cb, void *user_data);
+
+/**
+ * Print the frame times
+ * @param out the stream
+ * @param bench the finished benchmark
+ */
+void draw_bench_print(FILE *out, const draw_bench_t *bench);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*DRAW_BENCH_H*/
@@ -0,0 +1,94 @@
+/**
+ * @file fill_mix.c
+ *
+ * Pixel math of the chart fills
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "fill_mix.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+uint32_t fill_mix_xrgb8888(uint32_t dst, uint32_t color, uint8_t opa)
+{
+    uint32_t rb;
+    uint32_t g;
+
+    /* Red and blue mixed together, 8.8 fixed point */
+    rb = ((color & 0xFF00FFu) * opa + (dst & 0xFF00FFu) * (255u - opa)) >> 8;
+    g = ((color & 0x00FF00u) * opa + (dst & 0x00FF00u) * (255u - opa)) >> 8;
+
+    return 0xFF000000u | (rb & 0xFF00FFu) | (g & 0x00FF00u);
+}
+
+uint16_t fill_mix_rgb565(uint16_t dst, uint16_t color, uint8_t opa)
+{
+    uint32_t r = (((color >> 11) & 0x1Fu) * opa + ((dst >> 11) & 0x1Fu) * (255u - opa) + 127u) / 255u;
+    uint32_t g = (((color >> 5) & 0x3Fu) * opa + ((dst >> 5) & 0x3Fu) * (255u - opa) + 127u) / 255u;
+    uint32_t b = ((color & 0x1Fu) * opa + (dst & 0x1Fu) * (255u - opa) + 127u) / 255u;
+
+    return (uint16_t)((r << 11) | (g << 5) | b);
+}
+
+void fill_mix_ramp(uint8_t *ramp, int32_t h, uint8_t max_opa)
+{
+    int32_t y;
+
+    for (y = 0; y < h; y++) {
+        ramp[y] = (uint8_t)(max_opa * (h - y) / h);
+    }
+}
+
+void fill_mix_gradient_ramp(uint8_t *ramp, int32_t h, uint8_t max_opa)
+{
+    int32_t y;
+
+    for (y = 0; y < h; y++) {
+        ramp[y] = (uint8_t)(max_opa * (255 - y * 255 / h) / 255);
+    }
+}
+
+void fill_mix_opa_plane(uint8_t *plane, uint32_t stride, int32_t w, int32_t h,
+                        const uint8_t *ramp, const int32_t *top)
+{
+    uint8_t *opa;
+    int32_t x;
+    int32_t y;
+
+    for (y = 0; y < h; y++) {
+        opa = plane + (uint32_t)y * stride;
+
+        for (x = 0; x < w; x++) {
+            opa[x] = y >= top[x] ? ramp[y] : 0;
+        }
+    }
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
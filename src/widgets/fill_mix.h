@@ -0,0 +1,97 @@
+/**
+ * @file fill_mix.h
+ *
+ * Pixel math of the chart fills
+ *
+ * The color mixes and opacity ramps of the strip chart and of the
+ * lv_chart fill. They do not depend on LVGL, so they are tested
+ * without a display.
+ *
+ */
+
+#ifndef FILL_MIX_H
+#define FILL_MIX_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include <stdint.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Mix two XRGB8888 colors
+ * @param dst the pixel
+ * @param color the color mixed over it
+ * @param opa the opacity of the color
+ * @return the mixed color
+ */
+uint32_t fill_mix_xrgb8888(uint32_t dst, uint32_t color, uint8_t opa);
+
+/**
+ * Mix two RGB565 colors
+ *
+ * @description each channel is mixed at its own depth and rounded to
+ * the nearest step, opacity 0 and 255 give back the pixel and the color
+ * exactly
+ * @param dst the pixel
+ * @param color the color mixed over it
+ * @param opa the opacity of the color
+ * @return the mixed color
+ */
+uint16_t fill_mix_rgb565(uint16_t dst, uint16_t color, uint8_t opa);
+
+/**
+ * Build the opacity of each row of a strip chart fill, fading linearly
+ * from max_opa at the top to 0 at the bottom
+ * @param ramp destination, h entries
+ * @param h the plot height
+ * @param max_opa the opacity of the top row
+ */
+void fill_mix_ramp(uint8_t *ramp, int32_t h, uint8_t max_opa);
+
+/**
+ * Build the opacity of each row of an lv_chart fill, the same fade as
+ * a vertical gradient over the whole chart height
+ * @param ramp destination, h entries
+ * @param h the chart height
+ * @param max_opa the opacity of the top row
+ */
+void fill_mix_gradient_ramp(uint8_t *ramp, int32_t h, uint8_t max_opa);
+
+/**
+ * Write the opacity plane of a fill, the rows of each column from its
+ * top down get the ramp, the ones above it are transparent
+ * @param plane the first opacity row
+ * @param stride bytes between two opacity rows
+ * @param w the fill width
+ * @param h the fill height
+ * @param ramp the opacity of each row
+ * @param top the top row of each column, h for an empty column
+ */
+void fill_mix_opa_plane(uint8_t *plane, uint32_t stride, int32_t w, int32_t h,
+                        const uint8_t *ramp, const int32_t *top);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*FILL_MIX_H*/
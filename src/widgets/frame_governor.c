@@ -0,0 +1,150 @@
+/**
+ * @file frame_governor.c
+ *
+ * UI update rate governor
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "frame_governor.h"
+#include "../lib/simulator_util.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void frame_timer_cb(lv_timer_t *timer);
+static void refr_event_cb(lv_event_t *e);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void frame_governor_init(frame_governor_t *gov, uint32_t fps, bool adaptive,
+                         frame_governor_cb_t cb, void *user_data)
+{
+    lv_display_t *disp = lv_display_get_default();
+
+    if (fps == 0) {
+        fps = FRAME_GOVERNOR_FPS_DEFAULT;
+    }
+
+    gov->cb = cb;
+    gov->user_data = user_data;
+    gov->period_ms = fps < 1000 ? 1000 / fps : 1;
+    gov->adaptive = adaptive;
+    gov->pending = false;
+    gov->measuring = false;
+    gov->last_us = 0;
+    gov->refr_start_us = 0;
+    gov->render_us = 0;
+    gov->frames = 0;
+    gov->dropped = 0;
+
+    gov->timer = lv_timer_create(frame_timer_cb, gov->period_ms, gov);
+    lv_timer_pause(gov->timer);
+
+    if (adaptive && disp != NULL) {
+        lv_display_add_event_cb(disp, refr_event_cb, LV_EVENT_REFR_START, gov);
+        lv_display_add_event_cb(disp, refr_event_cb, LV_EVENT_REFR_READY, gov);
+    }
+}
+
+void frame_governor_request(frame_governor_t *gov)
+{
+    if (gov->pending) {
+        return;
+    }
+
+    gov->pending = true;
+    lv_timer_resume(gov->timer);
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Apply the pending updates once per frame
+ *
+ * @description the timer only runs while samples are pending, an idle
+ * governor does not wake the main loop up
+ * @param timer the frame timer
+ */
+static void frame_timer_cb(lv_timer_t *timer)
+{
+    frame_governor_t *gov = lv_timer_get_user_data(timer);
+    uint64_t now = get_monotonic_us();
+    uint64_t budget_us;
+
+    if (!gov->pending) {
+        lv_timer_pause(timer);
+        return;
+    }
+
+    /* Under load the samples wait for a later frame, none is lost */
+    if (gov->adaptive) {
+        budget_us = (uint64_t)gov->render_us * 100u / FRAME_GOVERNOR_LOAD_PCT;
+        if (now - gov->last_us < budget_us) {
+            gov->dropped++;
+            return;
+        }
+    }
+
+    gov->pending = false;
+    gov->last_us = now;
+    gov->measuring = gov->adaptive;
+    gov->frames++;
+    gov->cb(gov->user_data);
+}
+
+/**
+ * Measure the display refresh that renders a frame
+ * @param e LV_EVENT_REFR_START or LV_EVENT_REFR_READY of the display
+ */
+static void refr_event_cb(lv_event_t *e)
+{
+    frame_governor_t *gov = lv_event_get_user_data(e);
+    uint32_t elapsed;
+
+    if (!gov->measuring) {
+        return;
+    }
+
+    if (lv_event_get_code(e) == LV_EVENT_REFR_START) {
+        gov->refr_start_us = get_monotonic_us();
+        return;
+    }
+
+    if (gov->refr_start_us == 0) {
+        return;
+    }
+
+    elapsed = (uint32_t)(get_monotonic_us() - gov->refr_start_us);
+    gov->refr_start_us = 0;
+    gov->measuring = false;
+
+    /* Rises at once, decays over a few frames */
+    if (elapsed > gov->render_us) {
+        gov->render_us = elapsed;
+    } else {
+        gov->render_us -= (gov->render_us - elapsed) / 4;
+    }
+}
@@ -0,0 +1,101 @@
+/**
+ * @file frame_governor.h
+ *
+ * UI update rate governor
+ *
+ * Samples are stored as they arrive, but the widgets showing them are
+ * updated at most once per frame of the governor: the labels get the
+ * latest value, the charts every sample received since the last
+ * frame. The frame rate is independent of the display refresh period.
+ *
+ * In adaptive mode the time taken to render each update is measured,
+ * and frames are dropped while rendering would take more than half of
+ * the frame period.
+ *
+ */
+
+#ifndef FRAME_GOVERNOR_H
+#define FRAME_GOVERNOR_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "lvgl/lvgl.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/* Default frame rate, one frame per display refresh */
+#define FRAME_GOVERNOR_FPS_DEFAULT (1000 / LV_DEF_REFR_PERIOD)
+
+/* Share of the frame time rendering may take in adaptive mode */
+#define FRAME_GOVERNOR_LOAD_PCT 50
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**
+ * Apply the pending updates to the widgets
+ * @param user_data the user data given to frame_governor_init
+ */
+typedef void (*frame_governor_cb_t)(void *user_data);
+
+typedef struct {
+    lv_timer_t *timer;
+    frame_governor_cb_t cb;
+    void *user_data;
+    uint32_t period_ms;
+    bool adaptive;
+    bool pending;               /* Samples arrived since the last frame */
+    bool measuring;             /* The next refresh renders the last frame */
+    uint64_t last_us;           /* Time of the last frame */
+    uint64_t refr_start_us;
+    uint32_t render_us;         /* Average render time of a frame */
+    uint32_t frames;
+    uint32_t dropped;
+} frame_governor_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Initialize a governor, it is idle until frame_governor_request
+ *
+ * @param gov the governor to initialize
+ * @param fps the frame rate, 0 for FRAME_GOVERNOR_FPS_DEFAULT
+ * @param adaptive drop frames while rendering is too slow
+ * @param cb applies the updates, called from the LVGL timer handler
+ * @param user_data passed to cb
+ */
+void frame_governor_init(frame_governor_t *gov, uint32_t fps, bool adaptive,
+                         frame_governor_cb_t cb, void *user_data);
+
+/**
+ * Request a frame for new samples
+ *
+ * @description the first request after an idle period is applied at
+ * the next timer run, the following ones are coalesced until the next
+ * frame is due
+ * @param gov the governor
+ */
+void frame_governor_request(frame_governor_t *gov);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*FRAME_GOVERNOR_H*/
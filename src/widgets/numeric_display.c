@@ -0,0 +1,219 @@
+/**
+ * @file numeric_display.c
+ *
+ * Numeric display built from a pre-rendered glyph atlas
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include <stdio.h>
+#include <string.h>
+
+#include "numeric_display.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/* Glyph index of a character missing from the atlas */
+#define GLYPH_NONE 0xFF
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void render_atlas(numeric_display_t *nd, const lv_font_t *font, lv_color_t color,
+                         lv_color_t bg);
+static uint8_t glyph_of(const numeric_display_t *nd, char c);
+static void copy_cell(numeric_display_t *nd, uint32_t cell, uint8_t glyph);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+int numeric_display_init(numeric_display_t *nd, lv_obj_t *label, const char *units,
+                         uint32_t cell_cnt)
+{
+    lv_obj_t *parent = lv_obj_get_parent(label);
+    const lv_font_t *font = lv_obj_get_style_text_font(label, LV_PART_MAIN);
+    lv_color_format_t cf = lv_display_get_color_format(lv_obj_get_display(label));
+    int32_t w;
+    uint32_t i;
+
+    memset(nd, 0, sizeof(*nd));
+    snprintf(nd->charset, sizeof(nd->charset), "%s%s", NUMERIC_DISPLAY_DIGITS,
+             units != NULL ? units : "");
+    nd->glyph_cnt = (uint32_t)strlen(nd->charset);
+    nd->cell_cnt = cell_cnt < NUMERIC_DISPLAY_CELLS_MAX ? cell_cnt : NUMERIC_DISPLAY_CELLS_MAX;
+    nd->px_size = lv_color_format_get_size(cf);
+
+    /* Fixed width: the widest glyph sets the cell */
+    for (i = 0; i < nd->glyph_cnt; i++) {
+        w = lv_font_get_glyph_width(font, (uint8_t)nd->charset[i], 0);
+        if (w > nd->cell_w) {
+            nd->cell_w = w;
+        }
+    }
+    nd->cell_h = lv_font_get_line_height(font);
+
+    nd->atlas = lv_draw_buf_create(nd->cell_w * nd->glyph_cnt, nd->cell_h, cf, 0);
+    nd->buf = lv_draw_buf_create(nd->cell_w * nd->cell_cnt, nd->cell_h, cf, 0);
+    if (nd->atlas == NULL || nd->buf == NULL) {
+        if (nd->atlas != NULL) {
+            lv_draw_buf_destroy(nd->atlas);
+        }
+        if (nd->buf != NULL) {
+            lv_draw_buf_destroy(nd->buf);
+        }
+        return -1;
+    }
+
+    render_atlas(nd, font, lv_obj_get_style_text_color(label, LV_PART_MAIN),
+                 lv_obj_get_style_bg_color(parent, LV_PART_MAIN));
+
+    nd->canvas = lv_canvas_create(parent);
+    lv_canvas_set_draw_buf(nd->canvas, nd->buf);
+    lv_obj_remove_flag(nd->canvas, LV_OBJ_FLAG_CLICKABLE);
+    lv_obj_set_align(nd->canvas, lv_obj_get_style_align(label, LV_PART_MAIN));
+    lv_obj_set_pos(nd->canvas, lv_obj_get_x_aligned(label), lv_obj_get_y_aligned(label));
+    lv_obj_add_flag(label, LV_OBJ_FLAG_HIDDEN);
+
+    for (i = 0; i < nd->cell_cnt; i++) {
+        nd->shown[i] = glyph_of(nd, ' ');
+        copy_cell(nd, i, nd->shown[i]);
+    }
+
+    return 0;
+}
+
+bool numeric_display_set_text(numeric_display_t *nd, const char *text)
+{
+    lv_area_t coords;
+    lv_area_t area;
+    bool changed = false;
+    uint32_t cell;
+    uint8_t glyph;
+
+    lv_obj_get_coords(nd->canvas, &coords);
+    area.y1 = coords.y1;
+    area.y2 = coords.y1 + nd->cell_h - 1;
+
+    for (cell = 0; cell < nd->cell_cnt; cell++) {
+        glyph = GLYPH_NONE;
+        while (glyph == GLYPH_NONE && *text != '\0') {
+            glyph = glyph_of(nd, *text++);
+        }
+        if (glyph == GLYPH_NONE) {
+            glyph = glyph_of(nd, ' ');
+        }
+
+        if (glyph == nd->shown[cell]) {
+            continue;
+        }
+
+        copy_cell(nd, cell, glyph);
+        nd->shown[cell] = glyph;
+        changed = true;
+
+        area.x1 = coords.x1 + (int32_t)cell * nd->cell_w;
+        area.x2 = area.x1 + nd->cell_w - 1;
+        lv_obj_invalidate_area(nd->canvas, &area);
+    }
+
+    return changed;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Render every glyph of the charset into its atlas cell
+ *
+ * @description a temporary canvas lends its layer to the label renderer,
+ * the atlas buffer is kept when the canvas is deleted
+ * @param nd the display, its atlas allocated
+ * @param font the font
+ * @param color the text color
+ * @param bg the background color
+ */
+static void render_atlas(numeric_display_t *nd, const lv_font_t *font, lv_color_t color,
+                         lv_color_t bg)
+{
+    char glyph_text[NUMERIC_DISPLAY_GLYPHS_MAX][2];
+    lv_draw_label_dsc_t dsc;
+    lv_obj_t *canvas;
+    lv_layer_t layer;
+    lv_area_t area;
+    uint32_t i;
+
+    canvas = lv_canvas_create(lv_layer_top());
+    lv_obj_add_flag(canvas, LV_OBJ_FLAG_HIDDEN);
+    lv_canvas_set_draw_buf(canvas, nd->atlas);
+    lv_canvas_fill_bg(canvas, bg, LV_OPA_COVER);
+
+    lv_canvas_init_layer(canvas, &layer);
+    for (i = 0; i < nd->glyph_cnt; i++) {
+        /* The text is read when the layer is finished */
+        glyph_text[i][0] = nd->charset[i];
+        glyph_text[i][1] = '\0';
+
+        lv_draw_label_dsc_init(&dsc);
+        dsc.font = font;
+        dsc.color = color;
+        dsc.align = LV_TEXT_ALIGN_CENTER;
+        dsc.text = glyph_text[i];
+
+        area.x1 = (int32_t)i * nd->cell_w;
+        area.y1 = 0;
+        area.x2 = area.x1 + nd->cell_w - 1;
+        area.y2 = nd->cell_h - 1;
+        lv_draw_label(&layer, &dsc, &area);
+    }
+    lv_canvas_finish_layer(canvas, &layer);
+
+    lv_obj_delete(canvas);
+}
+
+/**
+ * Look a character up in the charset
+ * @param nd the display
+ * @param c the character
+ * @return its glyph index, GLYPH_NONE if missing
+ */
+static uint8_t glyph_of(const numeric_display_t *nd, char c)
+{
+    const char *p = c != '\0' ? strchr(nd->charset, c) : NULL;
+
+    return p != NULL ? (uint8_t)(p - nd->charset) : GLYPH_NONE;
+}
+
+/**
+ * Copy an atlas cell to a display cell
+ * @param nd the display
+ * @param cell the display cell
+ * @param glyph the glyph index
+ */
+static void copy_cell(numeric_display_t *nd, uint32_t cell, uint8_t glyph)
+{
+    uint32_t row_size = (uint32_t)nd->cell_w * nd->px_size;
+    int32_t y;
+
+    for (y = 0; y < nd->cell_h; y++) {
+        memcpy(lv_draw_buf_goto_xy(nd->buf, cell * nd->cell_w, y),
+               lv_draw_buf_goto_xy(nd->atlas, glyph * nd->cell_w, y), row_size);
+    }
+}
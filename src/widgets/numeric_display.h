@@ -0,0 +1,97 @@
+/**
+ * @file numeric_display.h
+ *
+ * Numeric display built from a pre-rendered glyph atlas
+ *
+ * The digits, the sign, the decimal point, the space and a few unit
+ * letters are rendered once, in the display's color format, into an
+ * atlas of fixed-width cells. The display is a canvas of one row of
+ * cells: setting a new text copies the atlas cell of each character
+ * that changed and invalidates only those cells, no text is shaped or
+ * blended again.
+ *
+ * The cells are opaque, drawn over the background color of the parent.
+ *
+ */
+
+#ifndef NUMERIC_DISPLAY_H
+#define NUMERIC_DISPLAY_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "lvgl/lvgl.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/* Characters of every atlas, the unit letters follow */
+#define NUMERIC_DISPLAY_DIGITS "0123456789.- "
+
+/* Largest number of characters of an atlas and of a display */
+#define NUMERIC_DISPLAY_GLYPHS_MAX 24
+#define NUMERIC_DISPLAY_CELLS_MAX 12
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+typedef struct {
+    lv_obj_t *canvas;
+    lv_draw_buf_t *atlas;           /* One cell per glyph, in charset order */
+    lv_draw_buf_t *buf;             /* The cells shown */
+    char charset[NUMERIC_DISPLAY_GLYPHS_MAX + 1];
+    uint32_t glyph_cnt;
+    int32_t cell_w;
+    int32_t cell_h;
+    uint32_t cell_cnt;
+    uint32_t px_size;               /* Bytes per pixel */
+    uint8_t shown[NUMERIC_DISPLAY_CELLS_MAX];   /* Glyph index of each cell */
+} numeric_display_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Replace a label with a numeric display
+ *
+ * @description the display takes the font, text color, alignment and
+ * position of the label, which is hidden. It starts blank
+ * @param nd the display to initialize
+ * @param label the label to replace
+ * @param units the unit letters to add to NUMERIC_DISPLAY_DIGITS, e.g. "VA"
+ * @param cell_cnt number of characters shown, at most NUMERIC_DISPLAY_CELLS_MAX
+ * @return 0 on success, -1 if the buffers could not be allocated
+ */
+int numeric_display_init(numeric_display_t *nd, lv_obj_t *label, const char *units,
+                         uint32_t cell_cnt);
+
+/**
+ * Show a text
+ *
+ * @description characters missing from the atlas are skipped, e.g. a
+ * newline. The text is cut or padded with spaces to the cell count
+ * @param nd the display
+ * @param text the text
+ * @return true if at least one cell changed
+ */
+bool numeric_display_set_text(numeric_display_t *nd, const char *text);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*NUMERIC_DISPLAY_H*/
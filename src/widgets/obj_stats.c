@@ -0,0 +1,129 @@
+/**
+ * @file obj_stats.c
+ *
+ * Object and style usage of a widget tree
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include <malloc.h>
+#include <sys/types.h>
+
+#include "obj_stats.h"
+#include "lvgl/src/core/lv_obj_private.h"
+#include "lvgl/src/core/lv_obj_style_private.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/* prop_cnt of a style built with LV_STYLE_CONST_INIT */
+#define STYLE_CONST_PROP_CNT 255
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static size_t local_style_size(uint32_t prop_cnt);
+static uint32_t const_prop_cnt(const lv_style_t *style);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void obj_stats_collect(lv_obj_t *obj, obj_stats_t *stats)
+{
+    const lv_style_t *style;
+    size_t list_bytes;
+    uint32_t child_cnt;
+    uint32_t i;
+
+    stats->obj_cnt++;
+    stats->style_cnt += obj->style_cnt;
+
+    list_bytes = obj->style_cnt * sizeof(lv_obj_style_t);
+    stats->style_bytes += list_bytes;
+    stats->local_equiv_bytes += list_bytes;
+
+    for (i = 0; i < obj->style_cnt; i++) {
+        style = obj->styles[i].style;
+
+        if (obj->styles[i].is_local) {
+            stats->local_cnt++;
+            stats->local_prop_cnt += style->prop_cnt;
+            stats->style_bytes += local_style_size(style->prop_cnt);
+            stats->local_equiv_bytes += local_style_size(style->prop_cnt);
+        } else if (style->prop_cnt == STYLE_CONST_PROP_CNT) {
+            stats->const_cnt++;
+            stats->local_equiv_bytes += local_style_size(const_prop_cnt(style));
+        }
+    }
+
+    child_cnt = lv_obj_get_child_count(obj);
+    for (i = 0; i < child_cnt; i++) {
+        obj_stats_collect(lv_obj_get_child(obj, (int32_t)i), stats);
+    }
+}
+
+size_t obj_stats_heap_used(void)
+{
+    struct mallinfo2 info = mallinfo2();
+
+    return info.uordblks + info.hblkhd;
+}
+
+void obj_stats_print(FILE *out, const char *name, const obj_stats_t *stats, size_t heap_before,
+                     size_t heap_after)
+{
+    fprintf(out, "%s: %u objects, %u styles (%u local with %u properties, %u constant)\n",
+            name, stats->obj_cnt, stats->style_cnt, stats->local_cnt, stats->local_prop_cnt,
+            stats->const_cnt);
+    fprintf(out, "%s: styles use %zu bytes, %zu bytes as local styles\n", name,
+            stats->style_bytes, stats->local_equiv_bytes);
+    fprintf(out, "%s: heap %zu bytes before, %zu bytes after, %zd bytes for the screen\n", name,
+            heap_before, heap_after, (ssize_t)(heap_after - heap_before));
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Estimate the heap of a local style
+ * @param prop_cnt its number of properties
+ * @return the style and its value and property arrays
+ */
+static size_t local_style_size(uint32_t prop_cnt)
+{
+    return sizeof(lv_style_t) + prop_cnt * (sizeof(lv_style_value_t) + sizeof(lv_style_prop_t));
+}
+
+/**
+ * Count the properties of a constant style
+ * @param style a style built with LV_STYLE_CONST_INIT
+ * @return the number of properties before LV_STYLE_CONST_PROPS_END
+ */
+static uint32_t const_prop_cnt(const lv_style_t *style)
+{
+    const lv_style_const_prop_t *props = style->values_and_props;
+    uint32_t cnt = 0;
+
+    while (props[cnt].prop != LV_STYLE_PROP_INV) {
+        cnt++;
+    }
+
+    return cnt;
+}
@@ -0,0 +1,83 @@
+/**
+ * @file obj_stats.h
+ *
+ * Object and style usage of a widget tree
+ *
+ * Counts the objects under a root and the styles attached to them,
+ * and estimates the heap they take: the style list of every object and
+ * every local style with its properties. Constant styles take no heap;
+ * for comparison, their cost as local styles is estimated too.
+ *
+ */
+
+#ifndef OBJ_STATS_H
+#define OBJ_STATS_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include <stdio.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "lvgl/lvgl.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+typedef struct {
+    uint32_t obj_cnt;
+    uint32_t style_cnt;             /* Style list entries of all objects */
+    uint32_t local_cnt;             /* Local styles among them */
+    uint32_t local_prop_cnt;        /* Properties of the local styles */
+    uint32_t const_cnt;             /* Constant styles among them */
+    size_t style_bytes;             /* Heap of the style lists and local styles */
+    size_t local_equiv_bytes;       /* style_bytes if the constant styles were local */
+} obj_stats_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Add an object and all its descendants to the statistics
+ * @param obj the root object
+ * @param stats the statistics, zeroed by the caller
+ */
+void obj_stats_collect(lv_obj_t *obj, obj_stats_t *stats);
+
+/**
+ * Get the bytes currently allocated from the C heap
+ * @return the bytes in use, 0 if the allocator does not tell
+ */
+size_t obj_stats_heap_used(void);
+
+/**
+ * Print the statistics of a tree
+ * @param out the stream
+ * @param name the name of the root
+ * @param stats the statistics
+ * @param heap_before heap in use before the tree was built
+ * @param heap_after heap in use after the tree was built
+ */
+void obj_stats_print(FILE *out, const char *name, const obj_stats_t *stats, size_t heap_before,
+                     size_t heap_after);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*OBJ_STATS_H*/
@@ -0,0 +1,167 @@
+/**
+ * @file readout.c
+ *
+ * Numeric label readout
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "readout.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static char *append_str(char *dst, const char *end, const char *str);
+static char *append_fixed(char *dst, const char *end, int32_t value, uint8_t decimals);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void readout_init(readout_t *ro, lv_obj_t *label, uint8_t scale, uint8_t decimals,
+                  const char *prefix, const char *suffix)
+{
+    uint8_t i;
+
+    if (scale > READOUT_SCALE_MAX) {
+        scale = READOUT_SCALE_MAX;
+    }
+    if (decimals > scale) {
+        decimals = scale;
+    }
+
+    ro->label = label;
+    ro->display = NULL;
+    ro->prefix = prefix;
+    ro->suffix = suffix;
+    ro->decimals = decimals;
+    ro->valid = false;
+    ro->shown = 0;
+    ro->text[0] = '\0';
+
+    ro->div = 1;
+    for (i = decimals; i < scale; i++) {
+        ro->div *= 10;
+    }
+}
+
+void readout_set_display(readout_t *ro, numeric_display_t *nd)
+{
+    ro->display = nd;
+    ro->valid = false;
+}
+
+bool readout_set(readout_t *ro, int32_t value)
+{
+    const char *end = ro->text + sizeof(ro->text) - 1;
+    int32_t half = ro->div / 2;
+    char *p = ro->text;
+
+    /* Round in 64 bits, value +/- half may not fit */
+    if (value < 0) {
+        value = (int32_t)(((int64_t)value - half) / ro->div);
+    } else {
+        value = (int32_t)(((int64_t)value + half) / ro->div);
+    }
+
+    if (ro->valid && value == ro->shown) {
+        return false;
+    }
+
+    p = append_str(p, end, ro->prefix);
+    p = append_fixed(p, end, value, ro->decimals);
+    p = append_str(p, end, ro->suffix);
+    *p = '\0';
+
+    ro->shown = value;
+    ro->valid = true;
+
+    if (ro->display != NULL) {
+        numeric_display_set_text(ro->display, ro->text);
+        return true;
+    }
+
+    /* The label keeps pointing to the buffer, it only measures the new text */
+    lv_label_set_text_static(ro->label, ro->text);
+    return true;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Append a string, truncated at the end of the buffer
+ * @param dst where to write
+ * @param end the last byte of the buffer, kept for the terminator
+ * @param str the string, may be NULL
+ * @return the position after the written characters
+ */
+static char *append_str(char *dst, const char *end, const char *str)
+{
+    if (str == NULL) {
+        return dst;
+    }
+
+    while (*str != '\0' && dst < end) {
+        *dst++ = *str++;
+    }
+
+    return dst;
+}
+
+/**
+ * Append a fixed-point number
+ *
+ * @description the digits are built backwards in a scratch buffer,
+ * with at least one digit before the decimal point
+ * @param dst where to write
+ * @param end the last byte of the buffer, kept for the terminator
+ * @param value the value, in units of the last decimal
+ * @param decimals the number of decimals
+ * @return the position after the written characters
+ */
+static char *append_fixed(char *dst, const char *end, int32_t value, uint8_t decimals)
+{
+    char digits[16];
+    char *p = digits + sizeof(digits);
+    uint32_t mag = value < 0 ? 0u - (uint32_t)value : (uint32_t)value;
+    uint8_t n = 0;
+
+    do {
+        if (n == decimals && decimals > 0) {
+            *--p = '.';
+        }
+        *--p = (char)('0' + mag % 10u);
+        mag /= 10u;
+        n++;
+    } while (mag != 0 || n <= decimals);
+
+    if (value < 0) {
+        *--p = '-';
+    }
+
+    while (p < digits + sizeof(digits) && dst < end) {
+        *dst++ = *p++;
+    }
+
+    return dst;
+}
@@ -0,0 +1,100 @@
+/**
+ * @file readout.h
+ *
+ * Numeric label readout
+ *
+ * A label showing a scaled integer, e.g. milli-volts as volts with two
+ * decimals. The text is formatted without printf into a buffer owned
+ * by the readout and set with lv_label_set_text_static, so an update
+ * neither allocates nor copies. A value that rounds to the digits
+ * already shown does not touch the label at all. Large readouts can be
+ * shown on a numeric display instead, which only redraws the changed
+ * characters.
+ *
+ */
+
+#ifndef READOUT_H
+#define READOUT_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "lvgl/lvgl.h"
+#include "numeric_display.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/* Longest text, prefix and suffix included */
+#define READOUT_TEXT_MAX 24
+
+/* Largest number of decimals of a value */
+#define READOUT_SCALE_MAX 6
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+typedef struct {
+    lv_obj_t *label;
+    numeric_display_t *display;     /* Shows the text instead of the label, may be NULL */
+    const char *prefix;
+    const char *suffix;
+    int32_t div;                /* 10^(scale - decimals) */
+    uint8_t decimals;
+    bool valid;                 /* shown holds the value on the label */
+    int32_t shown;              /* Value shown, in units of the last decimal */
+    char text[READOUT_TEXT_MAX];
+} readout_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Attach a readout to a label, the label text is left as is until the
+ * first readout_set
+ *
+ * @param ro the readout to initialize, it must outlive the label
+ * @param label the label
+ * @param scale decimals of the values given to readout_set, e.g. 3 for
+ * milli-units, at most READOUT_SCALE_MAX
+ * @param decimals decimals shown, at most scale
+ * @param prefix text before the digits, e.g. " ". May be NULL
+ * @param suffix text after the digits, e.g. " V". May be NULL
+ */
+void readout_init(readout_t *ro, lv_obj_t *label, uint8_t scale, uint8_t decimals,
+                  const char *prefix, const char *suffix);
+
+/**
+ * Show the readout on a numeric display instead of its label
+ * @param ro the readout
+ * @param nd the display, initialized over the readout's label
+ */
+void readout_set_display(readout_t *ro, numeric_display_t *nd);
+
+/**
+ * Show a value, rounded half away from zero to the decimals shown
+ * @param ro the readout
+ * @param value the value, with the scale given to readout_init
+ * @return true if the label text changed
+ */
+bool readout_set(readout_t *ro, int32_t value);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*READOUT_H*/
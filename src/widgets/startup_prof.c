@@ -0,0 +1,229 @@
+/**
+ * @file startup_prof.c
+ *
+ * Startup phase profiler
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "startup_prof.h"
+#include "../lib/simulator_util.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/* Field of the start time in /proc/self/stat, counted after the command name */
+#define STAT_STARTTIME_FIELD 20
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+typedef struct {
+    const char *name;
+    uint64_t us;
+} mark_t;
+
+typedef struct {
+    const char *name;
+    startup_prof_build_cb_t build;
+} deferred_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static uint64_t exec_age_us(void);
+static void refr_event_cb(lv_event_t *e);
+static void defer_timer_cb(lv_timer_t *timer);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static uint64_t origin_us;
+static mark_t marks[STARTUP_PROF_MARKS_MAX];
+static uint32_t mark_cnt;
+static deferred_t deferred[STARTUP_PROF_DEFER_MAX];
+static uint32_t deferred_cnt;
+static uint32_t deferred_next;
+static uint64_t first_frame_us;
+static bool flushed;
+static bool report_when_done;
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void startup_prof_init(void)
+{
+    uint64_t now = get_monotonic_us();
+
+    origin_us = now - exec_age_us();
+    mark_cnt = 0;
+    startup_prof_mark("exec to main");
+}
+
+void startup_prof_mark(const char *name)
+{
+    if (mark_cnt >= STARTUP_PROF_MARKS_MAX) {
+        return;
+    }
+
+    marks[mark_cnt].name = name;
+    marks[mark_cnt].us = get_monotonic_us();
+    mark_cnt++;
+}
+
+int startup_prof_defer(const char *name, startup_prof_build_cb_t build)
+{
+    if (deferred_cnt >= STARTUP_PROF_DEFER_MAX) {
+        return -1;
+    }
+
+    deferred[deferred_cnt].name = name;
+    deferred[deferred_cnt].build = build;
+    deferred_cnt++;
+
+    return 0;
+}
+
+void startup_prof_watch(lv_display_t *disp, bool report)
+{
+    report_when_done = report;
+    flushed = false;
+
+    lv_display_add_event_cb(disp, refr_event_cb, LV_EVENT_FLUSH_FINISH, NULL);
+    lv_display_add_event_cb(disp, refr_event_cb, LV_EVENT_REFR_READY, NULL);
+}
+
+void startup_prof_print(FILE *out)
+{
+    uint64_t prev = origin_us;
+    uint32_t i;
+
+    for (i = 0; i < mark_cnt; i++) {
+        fprintf(out, "startup: %-24s %8.1f ms %8.1f ms\n", marks[i].name,
+                (double)(marks[i].us - origin_us) / 1000.0,
+                (double)(marks[i].us - prev) / 1000.0);
+        prev = marks[i].us;
+    }
+
+    if (first_frame_us != 0) {
+        fprintf(out, "startup: first frame %.1f ms after exec, %s the %d ms target\n",
+                (double)(first_frame_us - origin_us) / 1000.0,
+                first_frame_us - origin_us <= STARTUP_PROF_TARGET_MS * 1000ull ? "within" : "over",
+                STARTUP_PROF_TARGET_MS);
+    }
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Get the time since the process was started
+ *
+ * @description the start time in /proc/self/stat is in clock ticks
+ * since boot, as is CLOCK_BOOTTIME. The command name may hold spaces
+ * and parentheses, the fields are counted from its closing one
+ * @return the age in microseconds, 0 if unknown
+ */
+static uint64_t exec_age_us(void)
+{
+    char buf[512];
+    unsigned long long ticks;
+    struct timespec ts;
+    uint64_t start_us;
+    uint64_t now_us;
+    long hz = sysconf(_SC_CLK_TCK);
+    char *p;
+    FILE *f;
+    size_t len;
+    int field;
+
+    f = fopen("/proc/self/stat", "r");
+    if (f == NULL) {
+        return 0;
+    }
+    len = fread(buf, 1, sizeof(buf) - 1, f);
+    fclose(f);
+    buf[len] = '\0';
+
+    p = strrchr(buf, ')');
+    if (p == NULL || hz <= 0 || clock_gettime(CLOCK_BOOTTIME, &ts) != 0) {
+        return 0;
+    }
+
+    for (field = 0; field < STAT_STARTTIME_FIELD && p != NULL; field++) {
+        p = strchr(p + 1, ' ');
+    }
+    if (p == NULL || sscanf(p, "%llu", &ticks) != 1) {
+        return 0;
+    }
+
+    start_us = ticks * 1000000ull / (uint64_t)hz;
+    now_us = (uint64_t)ts.tv_sec * 1000000ull + (uint64_t)ts.tv_nsec / 1000u;
+
+    return now_us > start_us ? now_us - start_us : 0;
+}
+
+/**
+ * Detect the first frame: a refresh that flushed something
+ *
+ * @description the builders run from a timer, the display is still
+ * finishing its refresh when the event is sent
+ * @param e LV_EVENT_FLUSH_FINISH or LV_EVENT_REFR_READY of the display
+ */
+static void refr_event_cb(lv_event_t *e)
+{
+    lv_display_t *disp = lv_event_get_target(e);
+    lv_timer_t *timer;
+
+    if (lv_event_get_code(e) == LV_EVENT_FLUSH_FINISH) {
+        flushed = true;
+        return;
+    }
+
+    if (!flushed) {
+        return;
+    }
+
+    first_frame_us = get_monotonic_us();
+    startup_prof_mark("first frame");
+    lv_display_remove_event_cb_with_user_data(disp, refr_event_cb, NULL);
+
+    deferred_next = 0;
+    timer = lv_timer_create(defer_timer_cb, 0, NULL);
+    lv_timer_set_repeat_count(timer, (int32_t)deferred_cnt + 1);
+}
+
+/**
+ * Run the next deferred builder, print the report after the last one
+ * @param timer the timer of the builders, it repeats once per builder and
+ * once more for the report
+ */
+static void defer_timer_cb(lv_timer_t *timer)
+{
+    LV_UNUSED(timer);
+
+    if (deferred_next < deferred_cnt) {
+        deferred[deferred_next].build();
+        startup_prof_mark(deferred[deferred_next].name);
+        deferred_next++;
+        return;
+    }
+
+    if (report_when_done) {
+        startup_prof_print(stdout);
+    }
+}
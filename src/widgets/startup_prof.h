@@ -0,0 +1,97 @@
+/**
+ * @file startup_prof.h
+ *
+ * Startup phase profiler
+ *
+ * Records the end of each startup phase relative to the exec of the
+ * process and watches the display for the first frame flushed to the
+ * panel. Widgets that are not needed on the first frame can be handed
+ * to the profiler as deferred builders: they run one by one after the
+ * first frame, each timed as a phase of its own.
+ *
+ * The exec time is read from /proc/self/stat, which counts in clock
+ * ticks (usually 10 ms). Without it, times are relative to
+ * startup_prof_init.
+ *
+ */
+
+#ifndef STARTUP_PROF_H
+#define STARTUP_PROF_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "lvgl/lvgl.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/* Largest number of phases, deferred builders included */
+#define STARTUP_PROF_MARKS_MAX 24
+
+/* Largest number of deferred builders */
+#define STARTUP_PROF_DEFER_MAX 8
+
+/* Time from exec to the first frame the report checks against */
+#define STARTUP_PROF_TARGET_MS 300
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+typedef void (*startup_prof_build_cb_t)(void);
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Find the exec time of the process, call first thing in main
+ */
+void startup_prof_init(void);
+
+/**
+ * Record the end of a phase
+ * @param name the phase, a string that outlives the profiler
+ */
+void startup_prof_mark(const char *name);
+
+/**
+ * Build widgets after the first frame instead of now
+ * @param name the phase recorded once the builder returns
+ * @param build the builder
+ * @return 0 on success, -1 if too many builders are deferred
+ */
+int startup_prof_defer(const char *name, startup_prof_build_cb_t build);
+
+/**
+ * Watch a display for its first frame, then run the deferred builders
+ * @param disp the display
+ * @param report print the phases to stdout once the builders are done
+ */
+void startup_prof_watch(lv_display_t *disp, bool report);
+
+/**
+ * Print the recorded phases
+ * @param out the stream
+ */
+void startup_prof_print(FILE *out);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*STARTUP_PROF_H*/
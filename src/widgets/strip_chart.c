@@ -0,0 +1,334 @@
+/**
+ * @file strip_chart.c
+ *
+ * Scrolling strip chart drawn incrementally into a cached buffer
+ *
+ * Sample i from the newest is plotted at x = w - 1 - i * sample_w. A
+ * refresh with n new samples moves every row left by n * sample_w
+ * pixels and draws the n segments ending at the right edge.
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include <string.h>
+
+#include "strip_chart.h"
+#include "fill_mix.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/* Line thickness in pixels, like the chart style */
+#define LINE_WIDTH 2
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void redraw(strip_chart_t *sc);
+static void scroll(strip_chart_t *sc, int32_t dx);
+static void clear_columns(strip_chart_t *sc, int32_t x1, int32_t x2);
+static void draw_segment(strip_chart_t *sc, int32_t x0, uint32_t age);
+static int32_t value_to_y(const strip_chart_t *sc, const strip_chart_series_t *ser, int32_t value);
+static uint32_t native_color(const strip_chart_t *sc, lv_color_t color);
+static void put_pixel(const strip_chart_t *sc, uint8_t *px, uint32_t color);
+static void blend_pixel(const strip_chart_t *sc, uint8_t *px, uint32_t color, lv_opa_t opa);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/* Pixel (x, y) of the buffer */
+#define PX(sc, x, y) ((sc)->buf->data + (uint32_t)(y) * (sc)->buf->header.stride + \
+                      (uint32_t)(x) * (sc)->px_size)
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+int strip_chart_init(strip_chart_t *sc, lv_obj_t *parent, lv_color_t bg, uint32_t point_cnt)
+{
+    lv_color_format_t cf = lv_display_get_color_format(lv_obj_get_display(parent));
+
+    memset(sc, 0, sizeof(*sc));
+
+    /* Coordinates are computed lazily, the parent may still have the
+     * size it was created with */
+    lv_obj_update_layout(parent);
+
+    sc->w = lv_obj_get_content_width(parent);
+    sc->h = lv_obj_get_content_height(parent);
+    if (sc->h > STRIP_CHART_HEIGHT_MAX) {
+        sc->h = STRIP_CHART_HEIGHT_MAX;
+    }
+    sc->bg = bg;
+    sc->sample_w = point_cnt > 1 ? sc->w / (int32_t)(point_cnt - 1) : sc->w;
+    if (sc->sample_w < 1) {
+        sc->sample_w = 1;
+    }
+
+    /* Pixels written directly by the rasteriser, in the display's depth */
+    cf = cf == LV_COLOR_FORMAT_RGB565 ? LV_COLOR_FORMAT_RGB565 : LV_COLOR_FORMAT_XRGB8888;
+    sc->px_size = lv_color_format_get_size(cf);
+    sc->buf = lv_draw_buf_create(sc->w, sc->h, cf, 0);
+    if (sc->buf == NULL) {
+        return -1;
+    }
+
+    sc->canvas = lv_canvas_create(parent);
+    lv_canvas_set_draw_buf(sc->canvas, sc->buf);
+    lv_obj_remove_flag(sc->canvas, LV_OBJ_FLAG_CLICKABLE);
+
+    return 0;
+}
+
+int strip_chart_add_series(strip_chart_t *sc, const telemetry_ring_t *ring, lv_color_t color,
+                           lv_opa_t max_opa, int32_t min, int32_t max)
+{
+    strip_chart_series_t *ser;
+
+    if (sc->series_cnt == STRIP_CHART_SERIES_MAX) {
+        return -1;
+    }
+
+    ser = &sc->series[sc->series_cnt++];
+    ser->ring = ring;
+    ser->color = color;
+    ser->min = min;
+    ser->max = max > min ? max : min + 1;
+
+    /* The fill fades linearly from max_opa at the top to 0 at the bottom */
+    fill_mix_ramp(ser->ramp, sc->h, max_opa);
+
+    sc->valid = false;
+    return 0;
+}
+
+bool strip_chart_refresh(strip_chart_t *sc)
+{
+    uint64_t count;
+    uint64_t fresh;
+    int32_t dx;
+    uint32_t age;
+
+    if (sc->series_cnt == 0) {
+        return false;
+    }
+
+    count = sc->series[0].ring->count;
+    fresh = count - sc->shown;
+    if (sc->valid && fresh == 0) {
+        return false;
+    }
+
+    if (!sc->valid || fresh * (uint64_t)sc->sample_w >= (uint64_t)sc->w) {
+        redraw(sc);
+    } else {
+        dx = (int32_t)fresh * sc->sample_w;
+        scroll(sc, dx);
+        clear_columns(sc, sc->w - dx, sc->w - 1);
+
+        /* Oldest new segment first, it ends where the next one starts */
+        for (age = (uint32_t)fresh; age-- > 0;) {
+            draw_segment(sc, sc->w - 1 - (int32_t)(age + 1) * sc->sample_w, age);
+        }
+    }
+
+    sc->shown = count;
+    sc->valid = true;
+    lv_obj_invalidate(sc->canvas);
+
+    return true;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Draw the whole plot from the rings
+ * @param sc the strip chart
+ */
+static void redraw(strip_chart_t *sc)
+{
+    uint32_t segments = (uint32_t)((sc->w - 1) / sc->sample_w + 1);
+    uint32_t age;
+
+    clear_columns(sc, 0, sc->w - 1);
+    for (age = segments; age-- > 0;) {
+        draw_segment(sc, sc->w - 1 - (int32_t)(age + 1) * sc->sample_w, age);
+    }
+}
+
+/**
+ * Move every row left
+ * @param sc the strip chart
+ * @param dx pixels to move by, less than the width
+ */
+static void scroll(strip_chart_t *sc, int32_t dx)
+{
+    int32_t y;
+
+    for (y = 0; y < sc->h; y++) {
+        memmove(PX(sc, 0, y), PX(sc, dx, y), (size_t)(sc->w - dx) * sc->px_size);
+    }
+}
+
+/**
+ * Fill columns with the background
+ * @param sc the strip chart
+ * @param x1 first column
+ * @param x2 last column
+ */
+static void clear_columns(strip_chart_t *sc, int32_t x1, int32_t x2)
+{
+    uint32_t bg = native_color(sc, sc->bg);
+    int32_t x;
+    int32_t y;
+
+    for (y = 0; y < sc->h; y++) {
+        for (x = x1; x <= x2; x++) {
+            put_pixel(sc, PX(sc, x, y), bg);
+        }
+    }
+}
+
+/**
+ * Draw the segment of every series ending at a sample
+ *
+ * @description the fills of all series go first so no fill covers a line.
+ * The column at x0 belongs to the previous segment and is not touched
+ * @param sc the strip chart
+ * @param x0 column of the previous sample, may be left of the plot
+ * @param age the sample the segment ends at, 0 for the newest
+ */
+static void draw_segment(strip_chart_t *sc, int32_t x0, uint32_t age)
+{
+    const strip_chart_series_t *ser;
+    int32_t y0[STRIP_CHART_SERIES_MAX];
+    int32_t y1[STRIP_CHART_SERIES_MAX];
+    bool skip[STRIP_CHART_SERIES_MAX];
+    int32_t v0;
+    int32_t v1;
+    int32_t x;
+    int32_t y;
+    int32_t ya;
+    int32_t yb;
+    uint32_t color;
+    uint32_t s;
+
+    for (s = 0; s < sc->series_cnt; s++) {
+        ser = &sc->series[s];
+        v0 = telemetry_ring_get(ser->ring, ser->ring->count - 1 - age - 1);
+        v1 = telemetry_ring_get(ser->ring, ser->ring->count - 1 - age);
+
+        /* Gaps and samples older than the ring are left blank */
+        skip[s] = age + 1 >= ser->ring->count || v0 == TELEMETRY_NONE || v1 == TELEMETRY_NONE;
+        if (!skip[s]) {
+            y0[s] = value_to_y(sc, ser, v0);
+            y1[s] = value_to_y(sc, ser, v1);
+        }
+    }
+
+    for (s = 0; s < sc->series_cnt; s++) {
+        if (skip[s]) {
+            continue;
+        }
+        ser = &sc->series[s];
+        color = native_color(sc, ser->color);
+
+        for (x = LV_MAX(x0 + 1, 0); x <= x0 + sc->sample_w && x < sc->w; x++) {
+            ya = y0[s] + (y1[s] - y0[s]) * (x - x0) / sc->sample_w;
+            for (y = ya; y < sc->h; y++) {
+                blend_pixel(sc, PX(sc, x, y), color, ser->ramp[y]);
+            }
+        }
+    }
+
+    for (s = 0; s < sc->series_cnt; s++) {
+        if (skip[s]) {
+            continue;
+        }
+        ser = &sc->series[s];
+        color = native_color(sc, ser->color);
+
+        /* Vertical run between the line heights of two neighbour columns */
+        for (x = LV_MAX(x0 + 1, 0); x <= x0 + sc->sample_w && x < sc->w; x++) {
+            ya = y0[s] + (y1[s] - y0[s]) * (x - 1 - x0) / sc->sample_w;
+            yb = y0[s] + (y1[s] - y0[s]) * (x - x0) / sc->sample_w;
+            for (y = LV_MIN(ya, yb); y <= LV_MAX(ya, yb) + LINE_WIDTH - 1 && y < sc->h; y++) {
+                put_pixel(sc, PX(sc, x, y), color);
+            }
+        }
+    }
+}
+
+/**
+ * Map a value to a row, clamped to the plot
+ * @param sc the strip chart
+ * @param ser the series, sets the range
+ * @param value the value in milli-units
+ * @return the row, 0 at the top
+ */
+static int32_t value_to_y(const strip_chart_t *sc, const strip_chart_series_t *ser, int32_t value)
+{
+    int64_t y = (int64_t)(ser->max - value) * (sc->h - 1) / (ser->max - ser->min);
+
+    return (int32_t)LV_CLAMP(0, y, sc->h - 1);
+}
+
+/**
+ * Convert a color to the pixel format of the buffer
+ * @param sc the strip chart
+ * @param color the color
+ * @return the pixel, RGB565 or XRGB8888
+ */
+static uint32_t native_color(const strip_chart_t *sc, lv_color_t color)
+{
+    if (sc->px_size == 2) {
+        return lv_color_to_u16(color);
+    }
+
+    return lv_color_to_u32(color) | 0xFF000000u;
+}
+
+/**
+ * Write a pixel
+ * @param sc the strip chart
+ * @param px the pixel
+ * @param color the color, from native_color
+ */
+static void put_pixel(const strip_chart_t *sc, uint8_t *px, uint32_t color)
+{
+    if (sc->px_size == 2) {
+        *(uint16_t *)px = (uint16_t)color;
+    } else {
+        *(uint32_t *)px = color;
+    }
+}
+
+/**
+ * Mix a color over a pixel
+ * @param sc the strip chart
+ * @param px the pixel
+ * @param color the color, from native_color
+ * @param opa the opacity of the color
+ */
+static void blend_pixel(const strip_chart_t *sc, uint8_t *px, uint32_t color, lv_opa_t opa)
+{
+    if (sc->px_size == 2) {
+        *(uint16_t *)px = fill_mix_rgb565(*(uint16_t *)px, (uint16_t)color, opa);
+    } else {
+        *(uint32_t *)px = fill_mix_xrgb8888(*(uint32_t *)px, color, opa);
+    }
+}
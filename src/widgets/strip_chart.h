@@ -0,0 +1,116 @@
+/**
+ * @file strip_chart.h
+ *
+ * Scrolling strip chart drawn incrementally into a cached buffer
+ *
+ * The plot lives in a canvas draw buffer that is kept between frames,
+ * in RGB565 on 16-bit displays and XRGB8888 otherwise.
+ * When samples arrive, the pixels already drawn are moved left by the
+ * width of the new samples and only the exposed columns are rasterised:
+ * the area fill under the line, then the line itself. The cost of a
+ * sample does not depend on how much history is visible.
+ *
+ * The series read their values from telemetry rings. The first series
+ * sets the pace, the others show their latest samples next to it.
+ *
+ */
+
+#ifndef STRIP_CHART_H
+#define STRIP_CHART_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "lvgl/lvgl.h"
+#include "../dps150/telemetry.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+#define STRIP_CHART_SERIES_MAX 2
+
+/* Tallest plot, sizes the opacity ramps */
+#define STRIP_CHART_HEIGHT_MAX 256
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+typedef struct {
+    const telemetry_ring_t *ring;
+    lv_color_t color;
+    int32_t min;                        /* Value at the bottom of the plot */
+    int32_t max;                        /* Value at the top of the plot */
+    uint8_t ramp[STRIP_CHART_HEIGHT_MAX];   /* Fill opacity of each row */
+} strip_chart_series_t;
+
+typedef struct {
+    lv_obj_t *canvas;
+    lv_draw_buf_t *buf;
+    lv_color_t bg;
+    uint32_t px_size;                   /* Bytes per pixel of the buffer */
+    int32_t w;
+    int32_t h;
+    int32_t sample_w;                   /* Pixels between two samples */
+    uint64_t shown;                     /* Ring count of the first series when last drawn */
+    bool valid;                         /* The buffer holds a complete plot */
+    strip_chart_series_t series[STRIP_CHART_SERIES_MAX];
+    uint32_t series_cnt;
+} strip_chart_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Create a strip chart filling the content area of an object
+ *
+ * @param sc the strip chart to initialize
+ * @param parent the object to draw into, e.g. an lv_chart only used for its axes
+ * @param bg the plot background color
+ * @param point_cnt samples visible across the plot, sets the sample width
+ * @return 0 on success, -1 if the buffer cannot be allocated
+ */
+int strip_chart_init(strip_chart_t *sc, lv_obj_t *parent, lv_color_t bg, uint32_t point_cnt);
+
+/**
+ * Add a series
+ *
+ * @param sc the strip chart
+ * @param ring the samples, in the ring's milli-units
+ * @param color the line color
+ * @param max_opa opacity of the fill at the top of the plot, fading to 0 at the bottom
+ * @param min value at the bottom of the plot
+ * @param max value at the top of the plot
+ * @return 0 on success, -1 if there is no free series
+ */
+int strip_chart_add_series(strip_chart_t *sc, const telemetry_ring_t *ring, lv_color_t color,
+                           lv_opa_t max_opa, int32_t min, int32_t max);
+
+/**
+ * Draw the samples that arrived since the last call
+ *
+ * @description scrolls the buffer and draws the new columns, or draws
+ * the whole plot if more than a plot width arrived
+ * @param sc the strip chart
+ * @return true if the plot changed
+ */
+bool strip_chart_refresh(strip_chart_t *sc);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*STRIP_CHART_H*/
@@ -0,0 +1,138 @@
+/**
+ * @file test_encode_alloc.c
+ *
+ * The DPS150 frame encoder must not allocate
+ *
+ * Linked with -Wl,--wrap=malloc,--wrap=calloc,--wrap=realloc so every
+ * allocation of the encoder is counted. Every command the application
+ * sends is encoded many times, the counter must stay at 0.
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../src/dps150/dps150_encode.h"
+#include "../src/dps150/dps150_regs.h"
+#include "test_util.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+#define ROUNDS 1000
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+void *__real_malloc(size_t size);
+void *__real_calloc(size_t nmemb, size_t size);
+void *__real_realloc(void *ptr, size_t size);
+static void encode_every_command(uint8_t *frame, float value);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+static volatile unsigned long allocations;
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void *__wrap_malloc(size_t size)
+{
+    allocations++;
+    return __real_malloc(size);
+}
+
+void *__wrap_calloc(size_t nmemb, size_t size)
+{
+    allocations++;
+    return __real_calloc(nmemb, size);
+}
+
+void *__wrap_realloc(void *ptr, size_t size)
+{
+    allocations++;
+    return __real_realloc(ptr, size);
+}
+
+int main(void)
+{
+    static const uint8_t get_all[] = DPS150_FRAME_U8(CMD_GET, DPS150_REG_ALL, 0);
+    uint8_t frame[DPS150_FRAME_MAX];
+    void *volatile probe;
+    size_t len;
+    uint32_t i;
+
+    /* The wrapper must see the allocations, or a count of 0 proves nothing */
+    probe = malloc(16);
+    free(probe);
+    check(allocations == 1, "malloc is counted");
+
+    /* The constant frames match the encoder, checksum included */
+    len = dps150_encode_get(frame, sizeof(frame), DPS150_REG_ALL);
+    check(len == sizeof(get_all) && memcmp(frame, get_all, len) == 0, "GET 255 frame");
+    check(memcmp(dps150_frame_get_all, get_all, sizeof(get_all)) == 0, "constant GET 255 frame");
+
+    allocations = 0;
+    for (i = 0; i < ROUNDS; i++) {
+        encode_every_command(frame, (float)i / 100.0f);
+    }
+    check(allocations == 0, "no allocation per command");
+
+    if (allocations != 0) {
+        fprintf(stderr, "%lu allocations for %u rounds\n", allocations, ROUNDS);
+    }
+
+    return TEST_RESULT();
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Encode every command type the application sends
+ * @param frame destination, DPS150_FRAME_MAX bytes
+ * @param value setpoint value
+ */
+static void encode_every_command(uint8_t *frame, float value)
+{
+    static const uint8_t session[] = { 1 };
+    static const uint8_t on[] = { 1 };
+    uint32_t i;
+
+    /* Polls of every register and of the status block */
+    for (i = 0; i < _DPS150_FIELD_CNT; i++) {
+        if (dps150_regs[i].reg != 0) {
+            check(dps150_encode_get(frame, DPS150_FRAME_MAX, dps150_regs[i].reg) > 0, "GET");
+        }
+    }
+    check(dps150_encode_get(frame, DPS150_FRAME_MAX, DPS150_REG_ALL) > 0, "GET 255");
+
+    /* Setpoints */
+    check(dps150_encode_float(frame, DPS150_FRAME_MAX, HEADER_OUTPUT, CMD_SET,
+                              DPS150_REG_SET_VOLTAGE, value) > 0, "SET voltage");
+    check(dps150_encode_float(frame, DPS150_FRAME_MAX, HEADER_OUTPUT, CMD_SET,
+                              DPS150_REG_SET_CURRENT, value) > 0, "SET current");
+
+    /* Output switch and session start */
+    check(dps150_encode(frame, DPS150_FRAME_MAX, HEADER_OUTPUT, CMD_SET, DPS150_REG_OUTPUT,
+                        on, sizeof(on)) > 0, "SET output");
+    check(dps150_encode(frame, DPS150_FRAME_MAX, HEADER_OUTPUT, CMD_XXX_193, 0,
+                        session, sizeof(session)) > 0, "session start");
+}
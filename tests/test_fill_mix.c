@@ -0,0 +1,277 @@
+/**
+ * @file test_fill_mix.c
+ *
+ * Pixel math of the chart fills
+ *
+ * The RGB565 mix is checked against a float reference for every pair
+ * of channel values and every opacity. The fills must fade
+ * monotonically from the series color to the background down their
+ * opacity ramps, the RGB565A8 opacity plane of the lv_chart fill
+ * included.
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../src/widgets/fill_mix.h"
+#include "test_util.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/* Opacity plane of an RGB565A8 image, with padded rows */
+#define PLANE_W 13
+#define PLANE_H 100
+#define PLANE_STRIDE 16
+#define SENTINEL 0xA5
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void check_mix(void);
+static void check_ramps(void);
+static void check_opa_plane(void);
+static int fades(uint16_t bg, uint16_t color, const uint8_t *opa, int32_t n);
+static uint32_t channel(uint16_t px, uint32_t shift, uint32_t mask);
+static uint16_t rgb565(uint32_t rgb);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/* Backgrounds and series colors of the dashboard, and the extremes */
+static const uint32_t colors[] = { 0x000000, 0xFFFFFF, 0x101010, 0xFF8000, 0x00A0FF, 0x2095F6 };
+
+/* Red, green and blue of an RGB565 pixel */
+static const uint32_t shifts[] = { 11, 5, 0 };
+static const uint32_t masks[] = { 0x1F, 0x3F, 0x1F };
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+int main(void)
+{
+    check_mix();
+    check_ramps();
+    check_opa_plane();
+
+    return TEST_RESULT();
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Mix every pair of channel values at every opacity, each channel must
+ * be within half a step of the float result
+ */
+static void check_mix(void)
+{
+    uint16_t color;
+    uint16_t dst;
+    uint16_t px;
+    uint32_t fails = 0;
+    uint32_t opa;
+    uint32_t i;
+    uint32_t j;
+    uint32_t c;
+    double ref;
+    double err;
+
+    /* i & 0x1F and i cover every red, green and blue value */
+    for (i = 0; i < 64; i++) {
+        color = (uint16_t)(((i & 0x1Fu) << 11) | (i << 5) | (0x1Fu - (i & 0x1Fu)));
+
+        for (j = 0; j < 64; j++) {
+            dst = (uint16_t)(((j & 0x1Fu) << 11) | (j << 5) | (0x1Fu - (j & 0x1Fu)));
+
+            for (opa = 0; opa < 256; opa++) {
+                px = fill_mix_rgb565(dst, color, (uint8_t)opa);
+
+                for (c = 0; c < 3; c++) {
+                    ref = (channel(color, shifts[c], masks[c]) * (double)opa +
+                           channel(dst, shifts[c], masks[c]) * (255.0 - opa)) / 255.0;
+                    err = channel(px, shifts[c], masks[c]) - ref;
+                    if (err > 0.5 || err < -0.5) {
+                        fails++;
+                    }
+                }
+            }
+
+            if (fill_mix_rgb565(dst, color, 0) != dst || fill_mix_rgb565(dst, color, 255) != color) {
+                fails++;
+            }
+        }
+    }
+
+    check(fails == 0, "RGB565 mix within half a step of the float reference");
+}
+
+/**
+ * Both ramps start at the opacity of the top row and never increase, the
+ * mixed colors fade to the background down every plot height
+ */
+static void check_ramps(void)
+{
+    static const uint8_t max_opas[] = { 255, 180, 150, 100, 1 };
+    uint8_t ramp[256];
+    uint8_t gradient[256];
+    uint32_t fails = 0;
+    uint32_t bg;
+    uint32_t fg;
+    uint32_t m;
+    int32_t h;
+
+    for (h = 1; h <= 256; h++) {
+        for (m = 0; m < sizeof(max_opas); m++) {
+            fill_mix_ramp(ramp, h, max_opas[m]);
+            fill_mix_gradient_ramp(gradient, h, max_opas[m]);
+
+            if (ramp[0] != max_opas[m] || gradient[0] != max_opas[m]) {
+                fails++;
+            }
+
+            for (bg = 0; bg < sizeof(colors) / sizeof(colors[0]); bg++) {
+                for (fg = 0; fg < sizeof(colors) / sizeof(colors[0]); fg++) {
+                    if (!fades(rgb565(colors[bg]), rgb565(colors[fg]), ramp, h) ||
+                        !fades(rgb565(colors[bg]), rgb565(colors[fg]), gradient, h)) {
+                        fails++;
+                    }
+                }
+            }
+        }
+    }
+
+    check(fails == 0, "monotonic fade down the ramps");
+}
+
+/**
+ * Write the opacity plane after a color plane, as in an RGB565A8 image.
+ * Only the rows from the top of each column get the ramp, the padding
+ * and the color plane are left alone
+ */
+static void check_opa_plane(void)
+{
+    static uint8_t buf[PLANE_STRIDE * 2 * PLANE_H + PLANE_STRIDE * PLANE_H + PLANE_STRIDE];
+    static const int32_t top[PLANE_W] = { 0, 1, 50, 99, 100, 100, 0, 37, 37, 38, 2, 98, 64 };
+    uint8_t *plane = buf + PLANE_STRIDE * 2 * PLANE_H;
+    uint8_t ramp[PLANE_H];
+    uint8_t column[PLANE_H];
+    uint32_t fails = 0;
+    uint32_t bg;
+    uint32_t i;
+    uint8_t want;
+    int32_t x;
+    int32_t y;
+
+    fill_mix_gradient_ramp(ramp, PLANE_H, 180);
+    memset(buf, SENTINEL, sizeof(buf));
+    fill_mix_opa_plane(plane, PLANE_STRIDE, PLANE_W, PLANE_H, ramp, top);
+
+    for (i = 0; i < PLANE_STRIDE * 2 * PLANE_H; i++) {
+        if (buf[i] != SENTINEL) {
+            fails++;
+        }
+    }
+
+    for (y = 0; y < PLANE_H; y++) {
+        for (x = 0; x < PLANE_STRIDE; x++) {
+            want = x >= PLANE_W ? SENTINEL : y >= top[x] ? ramp[y] : 0;
+            if (plane[y * PLANE_STRIDE + x] != want) {
+                fails++;
+            }
+        }
+    }
+
+    for (i = 0; i < PLANE_STRIDE; i++) {
+        if (plane[PLANE_STRIDE * PLANE_H + i] != SENTINEL) {
+            fails++;
+        }
+    }
+
+    check(fails == 0, "RGB565A8 opacity plane");
+
+    /* Composited over the background, each column fades from its top down */
+    fails = 0;
+    for (x = 0; x < PLANE_W; x++) {
+        for (y = 0; y < PLANE_H; y++) {
+            column[y] = plane[y * PLANE_STRIDE + x];
+        }
+
+        for (bg = 0; bg < sizeof(colors) / sizeof(colors[0]); bg++) {
+            if (top[x] < PLANE_H &&
+                !fades(rgb565(colors[bg]), rgb565(0xFF8000), column + top[x], PLANE_H - top[x])) {
+                fails++;
+            }
+        }
+    }
+
+    check(fails == 0, "monotonic fade down the opacity plane");
+}
+
+/**
+ * Check that a color mixed at a series of opacities gets no further
+ * from the background at any step, in every channel
+ * @param bg the background
+ * @param color the color mixed over it
+ * @param opa the opacities
+ * @param n number of opacities
+ * @return 1 if the mix fades monotonically
+ */
+static int fades(uint16_t bg, uint16_t color, const uint8_t *opa, int32_t n)
+{
+    uint32_t prev[3] = { UINT32_MAX, UINT32_MAX, UINT32_MAX };
+    uint32_t dist;
+    uint16_t px;
+    uint32_t c;
+    int32_t i;
+
+    for (i = 0; i < n; i++) {
+        if (i > 0 && opa[i] > opa[i - 1]) {
+            return 0;
+        }
+
+        px = fill_mix_rgb565(bg, color, opa[i]);
+        for (c = 0; c < 3; c++) {
+            dist = (uint32_t)abs((int)channel(px, shifts[c], masks[c]) -
+                                 (int)channel(bg, shifts[c], masks[c]));
+            if (dist > prev[c]) {
+                return 0;
+            }
+            prev[c] = dist;
+        }
+    }
+
+    return 1;
+}
+
+static uint32_t channel(uint16_t px, uint32_t shift, uint32_t mask)
+{
+    return (px >> shift) & mask;
+}
+
+/**
+ * Convert an RGB888 color to RGB565 like the display does
+ * @param rgb the color, 0xRRGGBB
+ * @return the RGB565 pixel
+ */
+static uint16_t rgb565(uint32_t rgb)
+{
+    return (uint16_t)(((rgb >> 8) & 0xF800u) | ((rgb >> 5) & 0x07E0u) | ((rgb >> 3) & 0x001Fu));
+}
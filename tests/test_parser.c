@@ -0,0 +1,175 @@
+/**
+ * @file test_parser.c
+ *
+ * Resynchronization of the DPS150 frame parser
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../src/dps150/dps150_encode.h"
+#include "../src/dps150/dps150_parser.h"
+#include "test_util.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/* Not in the register table */
+#define UNKNOWN_REG 0x10
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void frame_cb(uint8_t cmd, uint8_t type, const uint8_t *payload, uint8_t len,
+                     void *user_data);
+static size_t reply_195(uint8_t *out, float voltage);
+static size_t replies_195(uint8_t *out, uint32_t n);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+static uint32_t frames_195;
+static uint32_t frames_unknown;
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+int main(void)
+{
+    static const uint8_t false_header[] = { HEADER_INPUT, CMD_GET, 195, 0x64 };
+    static const uint8_t false_unknown[] = { HEADER_INPUT, CMD_GET, UNKNOWN_REG, 0x64 };
+    static const uint8_t unknown[] = { 0x01, 0x02, 0x03 };
+    static const uint8_t junk[] = { HEADER_INPUT, 0x00, HEADER_INPUT, HEADER_INPUT, 0x42 };
+    dps150_parser_t parser;
+    uint8_t stream[1024];
+    size_t len = 0;
+    size_t i;
+
+    /* A false header announcing 100 bytes must not swallow the frames after it */
+    dps150_parser_init(&parser, HEADER_INPUT, frame_cb, NULL);
+    memcpy(stream, false_header, sizeof(false_header));
+    len = sizeof(false_header);
+    len += replies_195(stream + len, 5);
+    frames_195 = 0;
+    dps150_parser_feed(&parser, stream, len);
+    check(frames_195 == 5, "frames after a false header");
+
+    /* The same stream fed one byte at a time */
+    dps150_parser_init(&parser, HEADER_INPUT, frame_cb, NULL);
+    frames_195 = 0;
+    for (i = 0; i < len; i++) {
+        dps150_parser_feed(&parser, stream + i, 1);
+    }
+    check(frames_195 == 5, "frames after a false header, byte by byte");
+
+    /* A reply of a register missing from the table is passed on */
+    dps150_parser_init(&parser, HEADER_INPUT, frame_cb, NULL);
+    len = dps150_encode(stream, sizeof(stream), HEADER_INPUT, CMD_GET, UNKNOWN_REG,
+                        unknown, sizeof(unknown));
+    len += reply_195(stream + len, 1.0f);
+    frames_195 = 0;
+    frames_unknown = 0;
+    dps150_parser_feed(&parser, stream, len);
+    check(frames_unknown == 1 && frames_195 == 1, "frame of an unknown register");
+
+    /* A false header of such a register holds the frames after it until its
+     * checksum fails, none of them is lost */
+    dps150_parser_init(&parser, HEADER_INPUT, frame_cb, NULL);
+    memcpy(stream, false_unknown, sizeof(false_unknown));
+    len = sizeof(false_unknown);
+    len += replies_195(stream + len, 10);
+    frames_195 = 0;
+    frames_unknown = 0;
+    dps150_parser_feed(&parser, stream, len);
+    check(frames_195 == 10 && frames_unknown == 0, "frames after a false unknown header");
+    check(parser.checksum_errors == 1, "checksum error of a false unknown header");
+
+    /* Junk, a bad checksum and repeated headers between valid frames */
+    dps150_parser_init(&parser, HEADER_INPUT, frame_cb, NULL);
+    len = reply_195(stream, 1.0f);
+    memcpy(stream + len, junk, sizeof(junk));
+    len += sizeof(junk);
+    len += reply_195(stream + len, 2.0f);
+    stream[len - 1] ^= 0xff;
+    len += reply_195(stream + len, 3.0f);
+    frames_195 = 0;
+    dps150_parser_feed(&parser, stream, len);
+    check(frames_195 == 2, "frames around junk and a bad checksum");
+    check(parser.checksum_errors == 1, "checksum errors");
+
+    /* A frame split by a reset is dropped, the next one is parsed */
+    dps150_parser_init(&parser, HEADER_INPUT, frame_cb, NULL);
+    len = reply_195(stream, 1.0f);
+    dps150_parser_feed(&parser, stream, len / 2);
+    dps150_parser_reset(&parser);
+    frames_195 = 0;
+    dps150_parser_feed(&parser, stream, len);
+    check(frames_195 == 1, "frame after a reset");
+
+    return TEST_RESULT();
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static void frame_cb(uint8_t cmd, uint8_t type, const uint8_t *payload, uint8_t len,
+                     void *user_data)
+{
+    (void)payload;
+    (void)user_data;
+
+    if (cmd == CMD_GET && type == 195 && len == 12) {
+        frames_195++;
+    } else if (cmd == CMD_GET && type == UNKNOWN_REG) {
+        frames_unknown++;
+    }
+}
+
+/**
+ * Build the output voltage, current and power reply of the device
+ * @param out destination, at least DPS150_FRAME_OVERHEAD + 12 bytes
+ * @param voltage the output voltage
+ * @return the frame length
+ */
+static size_t reply_195(uint8_t *out, float voltage)
+{
+    float values[3] = { voltage, 0.5f, voltage * 0.5f };
+
+    return dps150_encode(out, DPS150_FRAME_OVERHEAD + sizeof(values), HEADER_INPUT, CMD_GET,
+                         195, (const uint8_t *)values, sizeof(values));
+}
+
+/**
+ * Build consecutive output voltage, current and power replies
+ * @param out destination, at least n * (DPS150_FRAME_OVERHEAD + 12) bytes
+ * @param n number of replies
+ * @return the length of the replies
+ */
+static size_t replies_195(uint8_t *out, uint32_t n)
+{
+    size_t len = 0;
+    uint32_t i;
+
+    for (i = 0; i < n; i++) {
+        len += reply_195(out + len, 12.0f + (float)i);
+    }
+
+    return len;
+}
@@ -0,0 +1,172 @@
+/**
+ * @file test_strip_chart.c
+ *
+ * Incremental scrolling of the strip chart against a full redraw
+ *
+ * Two strip charts of the same size plot the same rings. One is
+ * refreshed incrementally, the other is redrawn in full after every
+ * batch of samples. Their buffers must hold the same pixels, in both
+ * pixel formats, gaps and batches wider than the plot included.
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../src/widgets/strip_chart.h"
+#include "test_util.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/* Content size of the dashboard charts */
+#define PLOT_W 247
+#define PLOT_H 100
+#define POINT_CNT 50
+
+#define ROUNDS 500
+#define CAPACITY TELEMETRY_CAPACITY_MIN
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void run(lv_display_t *disp, lv_color_format_t cf);
+static void append_batch(uint32_t n);
+static bool same_pixels(const strip_chart_t *a, const strip_chart_t *b);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+static uint64_t storage[STRIP_CHART_SERIES_MAX][TELEMETRY_STORAGE_WORDS(CAPACITY)];
+static telemetry_ring_t rings[STRIP_CHART_SERIES_MAX];
+static uint64_t now_us;
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+int main(void)
+{
+    lv_display_t *disp;
+
+    lv_init();
+    disp = lv_display_create(320, 240);
+
+    run(disp, LV_COLOR_FORMAT_XRGB8888);
+    run(disp, LV_COLOR_FORMAT_RGB565);
+
+    return TEST_RESULT();
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Compare incremental refreshes with full redraws in one pixel format
+ * @param disp the display, sets the format of the buffers
+ * @param cf the pixel format
+ */
+static void run(lv_display_t *disp, lv_color_format_t cf)
+{
+    strip_chart_t inc;
+    strip_chart_t full;
+    lv_obj_t *parent;
+    uint32_t round;
+    uint32_t s;
+    uint32_t n;
+
+    lv_display_set_color_format(disp, cf);
+
+    parent = lv_obj_create(lv_screen_active());
+    lv_obj_set_size(parent, PLOT_W, PLOT_H);
+
+    for (s = 0; s < STRIP_CHART_SERIES_MAX; s++) {
+        telemetry_ring_init(&rings[s], storage[s], CAPACITY);
+    }
+
+    if (strip_chart_init(&inc, parent, lv_color_hex(0x101010), POINT_CNT) != 0 ||
+        strip_chart_init(&full, parent, lv_color_hex(0x101010), POINT_CNT) != 0) {
+        check(0, "buffer allocation");
+        lv_obj_delete(parent);
+        return;
+    }
+
+    /* The buffer is sized from the layout, not from the default size */
+    check(inc.w == lv_obj_get_content_width(parent), "plot width");
+    check(inc.h == lv_obj_get_content_height(parent), "plot height");
+
+    strip_chart_add_series(&inc, &rings[0], lv_color_hex(0xFF8000), 180, 0, 100 * TELEMETRY_SCALE);
+    strip_chart_add_series(&full, &rings[0], lv_color_hex(0xFF8000), 180, 0, 100 * TELEMETRY_SCALE);
+    strip_chart_add_series(&inc, &rings[1], lv_color_hex(0x00A0FF), 150, 0, 30 * TELEMETRY_SCALE);
+    strip_chart_add_series(&full, &rings[1], lv_color_hex(0x00A0FF), 150, 0, 30 * TELEMETRY_SCALE);
+
+    srand(1);
+    for (round = 0; round < ROUNDS; round++) {
+        /* Mostly a few samples per frame, sometimes more than a plot width */
+        n = rand() % 50 == 0 ? POINT_CNT + (uint32_t)(rand() % 20) : (uint32_t)(rand() % 4);
+        append_batch(n);
+
+        strip_chart_refresh(&inc);
+        full.valid = false;
+        strip_chart_refresh(&full);
+
+        if (!same_pixels(&inc, &full)) {
+            fprintf(stderr, "round %u, %u samples, color format %d\n", round, n, (int)cf);
+            check(0, "incremental refresh differs from a full redraw");
+            break;
+        }
+    }
+
+    lv_obj_delete(parent);
+    lv_draw_buf_destroy(inc.buf);
+    lv_draw_buf_destroy(full.buf);
+}
+
+/**
+ * Append samples to every ring, with a few gaps
+ * @param n number of samples
+ */
+static void append_batch(uint32_t n)
+{
+    int32_t value;
+    uint32_t i;
+    uint32_t s;
+
+    for (i = 0; i < n; i++) {
+        now_us += 100000;
+        for (s = 0; s < STRIP_CHART_SERIES_MAX; s++) {
+            value = rand() % 40 == 0 ? TELEMETRY_NONE : rand() % (110 * TELEMETRY_SCALE);
+            telemetry_ring_append(&rings[s], value, now_us);
+        }
+    }
+}
+
+static bool same_pixels(const strip_chart_t *a, const strip_chart_t *b)
+{
+    int32_t y;
+
+    for (y = 0; y < a->h; y++) {
+        if (memcmp(a->buf->data + (uint32_t)y * a->buf->header.stride,
+                   b->buf->data + (uint32_t)y * b->buf->header.stride,
+                   (size_t)a->w * a->px_size) != 0) {
+            return false;
+        }
+    }
+
+    return true;
+}
@@ -0,0 +1,100 @@
+/**
+ * @file test_transact.c
+ *
+ * Deadlines and retries of the DPS150 request engine
+ *
+ * A request only times out once it is written to the link. While it
+ * waits to be written it is neither sent again nor given up, and the
+ * latency of a retried request is measured from its first write.
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "../src/dps150/dps150_transact.h"
+#include "test_util.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+#define REG 195
+#define MS 1000u
+#define TIMEOUT_US ((uint64_t)DPS150_TRANSACT_TIMEOUT_MS * MS)
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static int send_cb(uint8_t type, void *user_data);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+static uint32_t sends;
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+int main(void)
+{
+    dps150_transact_t t;
+    uint64_t now = 1000 * MS;
+    int32_t rtt;
+
+    /* A request still waiting to be written has no deadline */
+    dps150_transact_init(&t, send_cb, NULL);
+    check(dps150_transact_request(&t, REG, now) == 0, "request");
+    check(dps150_transact_next_deadline(&t) == DPS150_TRANSACT_NO_DEADLINE,
+          "no deadline before the write");
+    dps150_transact_tick(&t, now + 10 * TIMEOUT_US);
+    check(sends == 1 && t.retries == 0 && t.failed == 0, "no retry before the write");
+
+    /* The deadline starts at the write */
+    now += 10 * TIMEOUT_US;
+    dps150_transact_written(&t, REG, now);
+    check(dps150_transact_next_deadline(&t) == now + TIMEOUT_US, "deadline from the write");
+    dps150_transact_tick(&t, now + TIMEOUT_US - 1);
+    check(sends == 1, "no retry before the deadline");
+
+    /* The retry is sent once, however long it waits to be written */
+    dps150_transact_tick(&t, now + TIMEOUT_US);
+    check(sends == 2 && t.retries == 1, "retry at the deadline");
+    dps150_transact_tick(&t, now + 10 * TIMEOUT_US);
+    check(sends == 2 && t.retries == 1 && t.failed == 0, "no retry before the retry is written");
+
+    /* A late reply is timed from the first write */
+    dps150_transact_written(&t, REG, now + 10 * TIMEOUT_US);
+    rtt = dps150_transact_complete(&t, REG, now + 10 * TIMEOUT_US + 5 * MS);
+    check(rtt == (int32_t)(10 * TIMEOUT_US + 5 * MS), "latency from the first write");
+    check(t.inflight == 0 && dps150_transact_next_deadline(&t) == DPS150_TRANSACT_NO_DEADLINE,
+          "nothing in flight");
+
+    return TEST_RESULT();
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static int send_cb(uint8_t type, void *user_data)
+{
+    (void)type;
+    (void)user_data;
+
+    sends++;
+    return 0;
+}
@@ -0,0 +1,66 @@
+/**
+ * @file test_util.h
+ *
+ * Helpers shared by the unit tests
+ *
+ * A failed check is printed and counted, the test goes on so one run
+ * reports every failure. main returns TEST_RESULT().
+ *
+ */
+
+#ifndef TEST_UTIL_H
+#define TEST_UTIL_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include <stdio.h>
+#include <stdlib.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+static int test_failures;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Count a failure when a condition does not hold
+ * @param cond the condition
+ * @param what what was checked, printed on failure
+ */
+static inline void check(int cond, const char *what)
+{
+    if (!cond) {
+        fprintf(stderr, "FAIL: %s\n", what);
+        test_failures++;
+    }
+}
+
+/**********************
+ *      MACROS
+ **********************/
+
+/* Exit status of the test */
+#define TEST_RESULT() (test_failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE)
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*TEST_UTIL_H*/